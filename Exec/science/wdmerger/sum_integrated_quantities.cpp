@@ -99,6 +99,28 @@ Castro::sum_integrated_quantities ()
 
     wd_dist_init[problem::axis_1 - 1] = 1.0;
 
+    // All of the volume integrals on a level are done in a single pass
+    // over the state.
+
+    amrex::Vector<int> quantities = {vs_mass_x, vs_mass_y, vs_mass_z,
+                                     vs_mass,
+                                     vs_inertial_mom_x, vs_inertial_mom_y, vs_inertial_mom_z,
+                                     vs_inertial_angmom_x, vs_inertial_angmom_y, vs_inertial_angmom_z,
+#ifdef HYBRID_MOMENTUM
+                                     vs_rmom, vs_lmom, vs_pmom,
+#endif
+                                     vs_rho_E, vs_rho_K, vs_rho_e};
+
+#ifdef GRAVITY
+    if (do_grav)
+      quantities.push_back(vs_rho_phi_grav);
+#endif
+
+#ifdef ROTATION
+    if (do_rotation)
+      quantities.push_back(vs_rho_phi_rot);
+#endif
+
     for (int lev = 0; lev <= finest_level; lev++)
     {
 
@@ -106,40 +128,44 @@ Castro::sum_integrated_quantities ()
 
       Castro& ca_lev = getLevel(lev);
 
+      // Calculate total mass, momentum, angular momentum, and energy of system.
+
+      amrex::Vector<Real> sums = ca_lev.volWgtSums(quantities, time, local_flag);
+
+      int n = 0;
+
       for ( int i = 0; i < 3; i++ ) {
-        com[i] += ca_lev.locWgtSum("density", time, i, local_flag);
+        com[i] += sums[n++];
       }
 
-      // Calculate total mass, momentum, angular momentum, and energy of system.
-
-      mass += ca_lev.volWgtSum("density", time, local_flag);
+      mass += sums[n++];
 
-      momentum[0] += ca_lev.volWgtSum("inertial_momentum_x", time, local_flag);
-      momentum[1] += ca_lev.volWgtSum("inertial_momentum_y", time, local_flag);
-      momentum[2] += ca_lev.volWgtSum("inertial_momentum_z", time, local_flag);
+      for ( int i = 0; i < 3; i++ ) {
+        momentum[i] += sums[n++];
+      }
 
-      angular_momentum[0] += ca_lev.volWgtSum("inertial_angular_momentum_x", time, local_flag);
-      angular_momentum[1] += ca_lev.volWgtSum("inertial_angular_momentum_y", time, local_flag);
-      angular_momentum[2] += ca_lev.volWgtSum("inertial_angular_momentum_z", time, local_flag);
+      for ( int i = 0; i < 3; i++ ) {
+        angular_momentum[i] += sums[n++];
+      }
 
 #ifdef HYBRID_MOMENTUM
-      hybrid_momentum[0] += ca_lev.volWgtSum("rmom", time, local_flag);
-      hybrid_momentum[1] += ca_lev.volWgtSum("lmom", time, local_flag);
-      hybrid_momentum[2] += ca_lev.volWgtSum("pmom", time, local_flag);
+      for ( int i = 0; i < 3; i++ ) {
+        hybrid_momentum[i] += sums[n++];
+      }
 #endif
 
-      rho_E += ca_lev.volWgtSum("rho_E", time, local_flag);
-      rho_K += ca_lev.volWgtSum("kineng",time, local_flag);
-      rho_e += ca_lev.volWgtSum("rho_e", time, local_flag);
+      rho_E += sums[n++];
+      rho_K += sums[n++];
+      rho_e += sums[n++];
 
 #ifdef GRAVITY
       if (do_grav)
-        rho_phi += ca_lev.volProductSum("density", "phiGrav", time, local_flag);
+        rho_phi += sums[n++];
 #endif
 
 #ifdef ROTATION
       if (do_rotation)
-	rho_phirot += ca_lev.volProductSum("density", "phiRot", time, local_flag);
+        rho_phirot += sums[n++];
 #endif
 
     }
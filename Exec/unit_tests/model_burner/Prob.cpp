@@ -0,0 +1,162 @@
+/* Implementations of functions in Problem.H go here */
+
+#include <Castro.H>
+#include <Castro_F.H>
+#include <Castro_react_zone.H>
+#include <prob_parameters.H>
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+using namespace amrex;
+
+void
+Castro::problem_post_init() {
+
+    // Burn the initial data through burn_dt with react_state, using
+    // 1, 2, 4, ... threads up to the maximum, and report the
+    // throughput.  Each measurement is the fastest of problem::nreps
+    // burns, all starting from the initial data, after one untimed
+    // burn to warm up.
+
+    if (level != 0) return;
+
+    if (Burn_Stats_Type < 0) {
+        amrex::Error("model_burner needs castro.react_stats_plot = 1 to count the RHS evaluations");
+    }
+
+    MultiFab& S_new = get_new_data(State_Type);
+    MultiFab& R_new = get_new_data(Reactions_Type);
+    const MultiFab& stats = get_new_data(Burn_Stats_Type);
+
+    MultiFab S_init(grids, dmap, S_new.nComp(), 0);
+    MultiFab::Copy(S_init, S_new, 0, 0, S_new.nComp(), 0);
+
+    const Real time = state[State_Type].curTime();
+
+#ifdef _OPENMP
+    const int max_threads = problem::max_threads > 0 ? problem::max_threads : omp_get_max_threads();
+    const int orig_threads = omp_get_max_threads();
+#else
+    const int max_threads = 1;
+#endif
+
+    Vector<int> threads;
+    for (int t = 1; t < max_threads; t *= 2) {
+        threads.push_back(t);
+    }
+    threads.push_back(max_threads);
+
+    const int nthread_counts = static_cast<int>(threads.size());
+    const int nreps = amrex::max(1, problem::nreps);
+
+    Vector<Real> run_time(nthread_counts, 1.e200);
+    Vector<Real> zones_burned(nthread_counts, 0.0);
+    Vector<Real> rhs_calls(nthread_counts, 0.0);
+
+    int all_success = 1;
+
+    for (int n = 0; n < nthread_counts; ++n) {
+
+#ifdef _OPENMP
+        omp_set_num_threads(threads[n]);
+#endif
+
+        for (int rep = -1; rep < nreps; ++rep) {
+
+            MultiFab::Copy(S_new, S_init, 0, 0, S_new.nComp(), 0);
+
+            ParallelDescriptor::Barrier();
+            const Real strt_time = ParallelDescriptor::second();
+
+            const bool success = react_state(S_new, R_new, time, problem::burn_dt);
+
+            Real elapsed = ParallelDescriptor::second() - strt_time;
+            ParallelDescriptor::ReduceRealMax(elapsed);
+
+            if (!success) {
+                all_success = 0;
+            }
+
+            if (rep >= 0) {
+                run_time[n] = amrex::min(run_time[n], elapsed);
+            }
+
+        }
+
+        // Every burn does the same work, so we count it from the last
+        // one.  Zones that failed still count, since they were
+        // integrated.
+
+        ReduceOps<ReduceOpSum> reduce_op;
+        ReduceData<Real> reduce_data(reduce_op);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+
+        for (MFIter mfi(stats); mfi.isValid(); ++mfi) {
+
+            const Box& bx = mfi.validbox();
+
+            auto burn_stats = stats.const_array(mfi);
+
+            reduce_op.eval(bx, reduce_data,
+            [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> ReduceTuple
+            {
+                const int status = static_cast<int>(burn_stats(i,j,k,2));
+                return {(status == burn_status_burned || status == burn_status_failed) ? 1.0_rt : 0.0_rt};
+            });
+        }
+
+        ReduceTuple hv = reduce_data.value();
+        zones_burned[n] = amrex::get<0>(hv);
+        ParallelDescriptor::ReduceRealSum(zones_burned[n]);
+
+        rhs_calls[n] = stats.sum(0);
+
+    }
+
+#ifdef _OPENMP
+    omp_set_num_threads(orig_threads);
+#endif
+
+    // Leave the initial data in place for the plotfile.
+
+    MultiFab::Copy(S_new, S_init, 0, 0, S_new.nComp(), 0);
+
+    // Report the results as CSV, both to stdout and to problem::bench_file.
+
+    std::ostringstream report;
+
+    report << "# model_burner: " << grids.numPts() << " zones, "
+           << ParallelDescriptor::NProcs() << " ranks, burn_dt = " << problem::burn_dt
+           << ", best of " << nreps << " burns" << std::endl;
+
+    if (!all_success) {
+        report << "# warning: some burns failed" << std::endl;
+    }
+
+    report << "nthreads,time,zones_burned,zones_per_sec,rhs_per_sec,efficiency" << std::endl;
+
+    for (int n = 0; n < nthread_counts; ++n) {
+        const Real efficiency = run_time[0] / (static_cast<Real>(threads[n]) * run_time[n]);
+
+        report << threads[n] << ","
+               << std::setprecision(6) << std::scientific
+               << run_time[n] << ","
+               << static_cast<Long>(zones_burned[n]) << ","
+               << zones_burned[n] / run_time[n] << ","
+               << rhs_calls[n] / run_time[n] << ","
+               << std::fixed << std::setprecision(4) << efficiency << std::endl;
+    }
+
+    amrex::Print() << std::endl << report.str() << std::endl;
+
+    if (ParallelDescriptor::IOProcessor()) {
+        std::ofstream bench_file(problem::bench_file);
+        if (!bench_file.good()) {
+            amrex::FileOpenFailed(problem::bench_file);
+        }
+        bench_file << report.str();
+    }
+
+}
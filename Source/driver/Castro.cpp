@@ -83,11 +83,20 @@ Vector<AMRErrorTag> Castro::error_tags;
 
 Vector<std::unique_ptr<std::fstream>> Castro::data_logs;
 Vector<std::unique_ptr<std::fstream>> Castro::problem_data_logs;
+#ifdef REACTIONS
+std::unique_ptr<std::fstream> Castro::burn_stats_log;
+#endif
+
+Vector<std::unique_ptr<ScratchArena>> Castro::hydro_scratch;
 
 #ifdef TRUE_SDC
 int          Castro::SDC_NODES;
 Vector<Real> Castro::dt_sdc;
 Vector<Real> Castro::node_weights;
+Vector<Real> Castro::lsrk_A;
+Vector<Real> Castro::lsrk_B;
+Vector<Real> Castro::lsrk_c;
+Vector<Real> Castro::lsrk_weights;
 #endif
 
 #ifdef GRAVITY
@@ -134,12 +143,20 @@ IntVect      Castro::hydro_tile_size(1048576,1048576,1048576);
 IntVect      Castro::no_tile_size(1024,1024,1024);
 #endif
 
+Vector<TileTuner> Castro::hydro_tile_tuner;
+Vector<TileTuner> Castro::react_tile_tuner;
+
+Vector<int>  Castro::hydro_tile_size_by_level;
+Vector<int>  Castro::react_tile_size_by_level;
+
 // this will be reset upon restart
 Real         Castro::previousCPUTimeUsed = 0.0;
 
 Real         Castro::startCPUTime = 0.0;
 
 int          Castro::SDC_Source_Type = -1;
+int          Castro::Work_Estimate_Type = -1;
+int          Castro::Burn_Stats_Type = -1;
 int          Castro::num_state_type = 0;
 
 int          Castro::do_cxx_prob_initialize = 0;
@@ -188,6 +205,11 @@ Castro::variableCleanUp ()
   TracerPC = 0;
 #endif
 
+    // the arenas allocate from The_Arena, so they must be released
+    // before AMReX is finalized
+
+    hydro_scratch.clear();
+
     desc_lst.clear();
 
     ca_finalize_meth_params();
@@ -219,6 +241,16 @@ Castro::read_params ()
 
     using namespace castro;
 
+    // Amr only uses our work estimate if it is told to (it reads its
+    // parameters after ours)
+
+    if (load_balance_with_work_estimates == 1) {
+        ParmParse ppa("amr");
+        if (!ppa.contains("loadbalance_with_workestimates")) {
+            ppa.add("loadbalance_with_workestimates", 1);
+        }
+    }
+
 
     // Get boundary conditions
     Vector<int> lo_bc(AMREX_SPACEDIM), hi_bc(AMREX_SPACEDIM);
@@ -330,6 +362,11 @@ Castro::read_params ()
       amrex::Abort("Simplified SDC requires the numerical Jacobian now (jacobian = 2)");
     }
 #endif
+
+    // skipping a burn applies the species rates from the last burn
+    if (react_skip_tolerance > 0.0 && store_omegadot != 1) {
+        amrex::Error("castro.react_skip_tolerance > 0 requires castro.store_omegadot = 1.");
+    }
 #endif
     // sanity checks
 
@@ -346,6 +383,9 @@ Castro::read_params ()
     if (time_integration_method == SpectralDeferredCorrections) {
         amrex::Error("SDC is currently not enabled on GPUs.");
     }
+    if (time_integration_method == LowStorageRungeKutta) {
+        amrex::Error("Low-storage Runge-Kutta is currently not enabled on GPUs.");
+    }
 #endif
 
 
@@ -363,16 +403,38 @@ Castro::read_params ()
     }
 #endif
 
+    // The method-of-lines hydro source is only built with
+    // USE_TRUE_SDC, so both true SDC and the low-storage Runge-Kutta
+    // integration (which use it) need that, and that build can't use
+    // the CTU advance.
 #ifndef TRUE_SDC
     if (time_integration_method == SpectralDeferredCorrections) {
         amrex::Error("True SDC currently requires USE_TRUE_SDC=TRUE when compiling.");
     }
+    if (time_integration_method == LowStorageRungeKutta) {
+        amrex::Error("Low-storage Runge-Kutta currently requires USE_TRUE_SDC=TRUE when compiling.");
+    }
 #else
-    if (time_integration_method != SpectralDeferredCorrections) {
-        amrex::Error("When building with USE_TRUE_SDC=TRUE, only true SDC can be used.");
+    if (time_integration_method != SpectralDeferredCorrections &&
+        time_integration_method != LowStorageRungeKutta) {
+        amrex::Error("When building with USE_TRUE_SDC=TRUE, only true SDC or low-storage Runge-Kutta can be used.");
     }
 #endif
 
+    if (time_integration_method == LowStorageRungeKutta) {
+        if (lsrk_order != 3 && lsrk_order != 4) {
+            amrex::Error("castro.lsrk_order must be 3 or 4.");
+        }
+        if (sdc_order != 2) {
+            amrex::Error("Low-storage Runge-Kutta only works with the second-order MOL reconstruction (castro.sdc_order = 2).");
+        }
+#ifdef REACTIONS
+        if (do_react == 1) {
+            amrex::Error("Low-storage Runge-Kutta is a pure hydrodynamics integrator; use true SDC to couple reactions.");
+        }
+#endif
+    }
+
 #ifndef AMREX_USE_GPU
 
 #ifdef RADIATION
@@ -452,6 +514,12 @@ Castro::read_params ()
     if (do_radiation && time_integration_method != CornerTransportUpwind) {
         amrex::Error("Radiation is currently only supported for CTU time advancement.");
     }
+
+    // the radiation solver is rebuilt with the grids, so we cannot
+    // move a level to a new distribution underneath it
+    if (do_radiation && rebalance_int > 0) {
+        amrex::Error("castro.rebalance_int > 0 is not supported with radiation.");
+    }
 #endif
 
 #ifdef ROTATION
@@ -548,6 +616,23 @@ Castro::read_params ()
         }
     }
 
+    // tile sizes for each level, AMREX_SPACEDIM values per level.  Any
+    // level given here is not autotuned.
+
+    if (pp.contains("hydro_tile_size_by_level")) {
+        pp.getarr("hydro_tile_size_by_level", hydro_tile_size_by_level);
+        if (hydro_tile_size_by_level.size() % AMREX_SPACEDIM != 0) {
+            amrex::Error("castro.hydro_tile_size_by_level needs AMREX_SPACEDIM values per level");
+        }
+    }
+
+    if (pp.contains("react_tile_size_by_level")) {
+        pp.getarr("react_tile_size_by_level", react_tile_size_by_level);
+        if (react_tile_size_by_level.size() % AMREX_SPACEDIM != 0) {
+            amrex::Error("castro.react_tile_size_by_level needs AMREX_SPACEDIM values per level");
+        }
+    }
+
     // Override Amr defaults. Note: this function is called after Amr::Initialize()
     // in Amr::InitAmr(), right before the ParmParse checks, so if the user opts to
     // override our overriding, they can do so.
@@ -795,6 +880,93 @@ Castro::buildMetrics ()
     wall_time_start = 0.0;
 }
 
+void
+Castro::init_tile_tuners ()
+{
+    const int nlevs = parent->maxLevel() + 1;
+
+    if (hydro_tile_tuner.size() < nlevs) {
+        hydro_tile_tuner.resize(nlevs);
+        react_tile_tuner.resize(nlevs);
+    }
+
+    // we tune over the first hydro_tile_autotune_steps coarse steps
+    // after this level first exists
+
+    const bool tune = hydro_tile_autotune_steps > 0;
+    const int end_step = parent->levelSteps(0) + hydro_tile_autotune_steps;
+
+    if (!hydro_tile_tuner[level].defined()) {
+        if (static_cast<int>(hydro_tile_size_by_level.size()) >= (level + 1) * AMREX_SPACEDIM) {
+            hydro_tile_tuner[level].pin(IntVect(&hydro_tile_size_by_level[level * AMREX_SPACEDIM]));
+        } else {
+            hydro_tile_tuner[level].define(hydro_tile_size, tune, end_step);
+        }
+    }
+
+    if (!react_tile_tuner[level].defined()) {
+        if (static_cast<int>(react_tile_size_by_level.size()) >= (level + 1) * AMREX_SPACEDIM) {
+            react_tile_tuner[level].pin(IntVect(&react_tile_size_by_level[level * AMREX_SPACEDIM]));
+        } else {
+            react_tile_tuner[level].define(FabArrayBase::mfiter_tile_size, tune, end_step);
+        }
+    }
+}
+
+
+IntVect
+Castro::get_hydro_tile_size ()
+{
+    init_tile_tuners();
+
+    TileTuner& tuner = hydro_tile_tuner[level];
+
+    if (tuner.tuning() && parent->levelSteps(0) >= tuner.end_step()) {
+        tuner.finalize("hydro", level, verbose > 0);
+        if (verbose > 0) {
+            amrex::Print() << "    (to pin this, set castro.hydro_tile_size_by_level)" << std::endl << std::endl;
+        }
+    }
+
+    return tuner.tile_size();
+}
+
+
+MFItInfo
+Castro::get_react_tiling ()
+{
+#ifdef AMREX_USE_GPU
+    return TilingIfNotGPU();
+#else
+    init_tile_tuners();
+
+    TileTuner& tuner = react_tile_tuner[level];
+
+    if (tuner.tuning() && parent->levelSteps(0) >= tuner.end_step()) {
+        tuner.finalize("reactions", level, verbose > 0);
+        if (verbose > 0) {
+            amrex::Print() << "    (to pin this, set castro.react_tile_size_by_level)" << std::endl << std::endl;
+        }
+    }
+
+    return MFItInfo().EnableTiling(tuner.tile_size());
+#endif
+}
+
+
+void
+Castro::record_tile_timing (TileTuner& tuner, const Real start_time)
+{
+    if (!tuner.tuning()) {
+        return;
+    }
+
+    const Real run_time = ParallelDescriptor::second() - start_time;
+
+    tuner.record(run_time / static_cast<Real>(grids.numPts()));
+}
+
+
 // Initialize the MultiFabs and flux registers that live as class members.
 
 void
@@ -897,6 +1069,8 @@ Castro::initMFs()
 
     post_step_regrid = 0;
 
+    box_cost.assign(grids.size(), 0.0);
+
     lastDtRetryLimited = false;
     lastDtFromRetry = 1.e200;
 
@@ -987,8 +1161,14 @@ Castro::initData ()
 #ifdef REACTIONS
     MultiFab &React_new = get_new_data(Reactions_Type);
     React_new.setVal(0.);
+
+    if (Burn_Stats_Type >= 0) {
+        get_new_data(Burn_Stats_Type).setVal(0.);
+    }
 #endif
 
+    update_work_estimate();
+
 #ifdef SIMPLIFIED_SDC
 #ifdef REACTIONS
    if (time_integration_method == SimplifiedSpectralDeferredCorrections) {
@@ -1523,31 +1703,84 @@ Castro::estTimeStep ()
     // criterion, we will get exactly max_dt for a timestep.
 
     Real estdt_hydro = max_dt / cfl;
+#ifdef DIFFUSION
+    Real estdt_diffusion = max_dt / cfl;
+#endif
+#ifdef REACTIONS
+    Real estdt_burn = max_dt;
+#endif
+
+    // If the last hydro update found the CFL-limited timestep from
+    // its signal speeds, and nothing has changed the state since, we
+    // don't need to sweep over the level for it again.
+
+    const bool use_hydro_harvest = do_hydro && hydro_estdt_harvest_valid;
+
+    if (fused_timestep_estimate == 1) {
+
+        // one sweep over the level evaluates all of the active limiters,
+        // and one reduction gets the global minimum of each
+
+        Real estdt_all[3];
+        estdt_fused(time, !use_hydro_harvest, estdt_all[0], estdt_all[1], estdt_all[2]);
+
+        if (use_hydro_harvest) {
+            estdt_all[0] = hydro_estdt_harvest;
+        }
+
+        ParallelDescriptor::ReduceRealMin(estdt_all, 3);
+
+        if (do_hydro) {
+            estdt_hydro = estdt_all[0];
+        }
+#ifdef DIFFUSION
+        if (diffuse_temp) {
+            estdt_diffusion = estdt_all[1];
+        }
+#endif
+#ifdef REACTIONS
+        if (do_react) {
+            estdt_burn = estdt_all[2];
+        }
+#endif
+
+    }
 
     if (do_hydro)
     {
 
+        if (fused_timestep_estimate != 1 && use_hydro_harvest) {
+
+            estdt_hydro = hydro_estdt_harvest;
+
+            ParallelDescriptor::ReduceRealMin(estdt_hydro);
+
+        } else if (fused_timestep_estimate != 1) {
+
 #ifdef RADIATION
-        if (Radiation::rad_hydro_combined) {
+            if (Radiation::rad_hydro_combined) {
 
-            estdt_hydro = estdt_rad();
+                estdt_hydro = estdt_rad();
 
-        }
-        else
-        {
+            }
+            else
+            {
 #endif
 
 #ifdef MHD
-          estdt_hydro = estdt_mhd();
+              estdt_hydro = estdt_mhd();
 #else
-          estdt_hydro = estdt_cfl(time);
+              estdt_hydro = estdt_cfl(time);
 #endif
 
 #ifdef RADIATION
-        }
+            }
 #endif
 
-        ParallelDescriptor::ReduceRealMin(estdt_hydro);
+            ParallelDescriptor::ReduceRealMin(estdt_hydro);
+
+        }
+
         estdt_hydro *= cfl;
         if (verbose) {
             amrex::Print() << "...estimated hydro-limited timestep at level " << level << ": " << estdt_hydro << std::endl;
@@ -1567,14 +1800,17 @@ Castro::estTimeStep ()
     // Note that the diffusion uses the same CFL safety factor
     // as the main hydrodynamics timestep limiter.
 
-    Real estdt_diffusion = max_dt / cfl;
+    if (fused_timestep_estimate != 1) {
+
+      if (diffuse_temp)
+      {
+        estdt_diffusion = estdt_temp_diffusion();
+      }
+
+      ParallelDescriptor::ReduceRealMin(estdt_diffusion);
 
-    if (diffuse_temp)
-    {
-      estdt_diffusion = estdt_temp_diffusion();
     }
 
-    ParallelDescriptor::ReduceRealMin(estdt_diffusion);
     estdt_diffusion *= cfl;
     if (verbose) {
         amrex::Print() << "...estimated diffusion-limited timestep at level " << level << ": " << estdt_diffusion << std::endl;
@@ -1589,16 +1825,15 @@ Castro::estTimeStep ()
 #endif  // diffusion
 
 #ifdef REACTIONS
-    // Dummy value to start with
-    Real estdt_burn = max_dt;
-
     if (do_react) {
 
         // Compute burning-limited timestep.
 
-        estdt_burn = estdt_burning();
+        if (fused_timestep_estimate != 1) {
+            estdt_burn = estdt_burning();
 
-        ParallelDescriptor::ReduceRealMin(estdt_burn);
+            ParallelDescriptor::ReduceRealMin(estdt_burn);
+        }
 
         if (verbose && estdt_burn < max_dt) {
             amrex::Print() << "...estimated burning-limited timestep at level " << level << ": " << estdt_burn << std::endl;
@@ -1919,6 +2154,17 @@ Castro::post_timestep (int iteration_local)
     if (level < finest_level)
         avgDown();
 
+    // The reflux and average-down change the state, so the signal
+    // speeds from the hydro update and the rates from the last burn
+    // no longer describe it.
+
+    if (level < finest_level) {
+        hydro_estdt_harvest_valid = false;
+#ifdef REACTIONS
+        burn_rates_time = -1.e200;
+#endif
+    }
+
 
 #ifdef MHD
     MultiFab& Bx_new = get_new_data(Mag_Type_x);
@@ -1947,6 +2193,12 @@ Castro::post_timestep (int iteration_local)
 
 #endif
 
+    // The reflux and average-down (and the problem hook) may have
+    // changed the state here, and so the ghost cells of the finer
+    // levels, so anything derived from it earlier is stale.
+
+    clear_derive_cache(true);
+
     if (level == 0)
     {
         int nstep = parent->levelSteps(0);
@@ -2104,6 +2356,10 @@ Castro::post_restart ()
     problem_post_restart();
 #endif
 
+    // the work estimate is not stored in the checkpoint
+
+    update_work_estimate();
+
 }
 
 void
@@ -2116,6 +2372,12 @@ Castro::postCoarseTimeStep (Real cumtime)
     if (do_grav)
         gravity->set_mass_offset(cumtime, 0);
 #endif
+
+    // Rebalancing may replace this level, so it must come last.
+
+    if (rebalance_int > 0 && parent->levelSteps(0) % rebalance_int == 0) {
+        rebalance(parent);
+    }
 }
 
 void
@@ -2127,6 +2389,8 @@ Castro::post_regrid (int lbase,
 
     fine_mask.clear();
 
+    clear_derive_cache();
+
 #ifdef AMREX_PARTICLES
     if (TracerPC && level == lbase) {
         TracerPC->Redistribute(lbase);
@@ -2241,6 +2505,10 @@ Castro::post_init (Real /*stop_time*/)
         return;
     }
 
+    // the initialization may have changed the state on any level
+
+    clear_derive_cache(true);
+
     //
     // Average data down from finer levels
     // so that conserved data is consistent between levels.
@@ -3123,6 +3391,8 @@ Castro::avgDown (int state_indx)
     MultiFab&  S_crse   = get_new_data(state_indx);
     MultiFab&  S_fine   = fine_lev.get_new_data(state_indx);
 
+    clear_derive_cache(true);
+
     amrex::average_down(S_fine, S_crse,
                          fgeom, cgeom,
                          0, S_fine.nComp(), fine_ratio);
@@ -3166,11 +3436,11 @@ Castro::errorEst (TagBoxArray& tags,
     // Apply each of the tagging criteria defined in the inputs.
 
     for (int j = 0; j < error_tags.size(); j++) {
-        std::unique_ptr<MultiFab> mf;
+        const MultiFab* mf = nullptr;
         if (error_tags[j].Field() != std::string()) {
-            mf = derive(error_tags[j].Field(), time, error_tags[j].NGrow());
+            mf = &derive_cached(error_tags[j].Field(), time, error_tags[j].NGrow());
         }
-        error_tags[j](tags, mf.get(), TagBox::CLEAR, TagBox::SET, time, level, geom);
+        error_tags[j](tags, mf, TagBox::CLEAR, TagBox::SET, time, level, geom);
     }
 
     // Now we'll tag any user-specified zones using the full state array.
@@ -3312,6 +3582,18 @@ Castro::derive (const std::string& name,
 
     BL_PROFILE("Castro::derive()");
 
+    // if we already have this quantity, we only need to copy it
+
+    if (derive_cache_enabled && derive_cache_size > 0) {
+        const MultiFab* cached = derive_cache.find(name, time, ngrow);
+        if (cached != nullptr) {
+            auto mf = std::make_unique<MultiFab>(cached->boxArray(), cached->DistributionMap(),
+                                                 cached->nComp(), ngrow);
+            MultiFab::Copy(*mf, *cached, 0, 0, cached->nComp(), ngrow);
+            return mf;
+        }
+    }
+
 #ifdef AMREX_PARTICLES
   return ParticleDerive(name,time,ngrow);
 #else
@@ -3319,6 +3601,42 @@ Castro::derive (const std::string& name,
 #endif
 }
 
+const MultiFab&
+Castro::derive_cached (const std::string& name,
+                       Real           time,
+                       int            ngrow)
+{
+
+    BL_PROFILE("Castro::derive_cached()");
+
+    if (!derive_cache_enabled || derive_cache_size <= 0) {
+        derive_scratch = derive(name, time, ngrow);
+        return *derive_scratch;
+    }
+
+    const MultiFab* cached = derive_cache.find(name, time, ngrow);
+    if (cached != nullptr) {
+        return *cached;
+    }
+
+    const Long max_bytes = static_cast<Long>(derive_cache_size) * 1024 * 1024;
+
+    return derive_cache.insert(name, time, ngrow, derive(name, time, ngrow), max_bytes);
+}
+
+void
+Castro::clear_derive_cache (bool finer)
+{
+    derive_cache.clear();
+    derive_scratch.reset();
+
+    if (finer) {
+        for (int lev = level+1; lev <= parent->finestLevel(); ++lev) {
+            getLevel(lev).derive_cache.clear();
+        }
+    }
+}
+
 void
 Castro::derive (const std::string& name,
                 Real           time,
@@ -4164,6 +4482,216 @@ Castro::getCPUTime()
 }
 
 
+void
+Castro::update_work_estimate ()
+{
+    BL_PROFILE("Castro::update_work_estimate()");
+
+    if (Work_Estimate_Type < 0) {
+        return;
+    }
+
+    MultiFab& work = get_new_data(Work_Estimate_Type);
+
+    const Real hydro_cost = load_balance_hydro_cost;
+
+#ifdef REACTIONS
+    // the burn weights are the number of RHS evaluations plus twice
+    // the number of Jacobian evaluations in the last burn
+
+    const bool add_burn_weights = do_react == 1;
+    const MultiFab& R_new = get_new_data(Reactions_Type);
+#endif
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(work, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+
+        auto W = work.array(mfi);
+#ifdef REACTIONS
+        auto reactions = R_new.const_array(mfi);
+#endif
+
+        amrex::ParallelFor(bx,
+        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+        {
+            W(i,j,k) = hydro_cost;
+#ifdef REACTIONS
+            if (add_burn_weights) {
+                W(i,j,k) += reactions(i,j,k,1);
+            }
+#endif
+        });
+    }
+}
+
+Real
+Castro::box_timer_start () const
+{
+    if (rebalance_int <= 0) {
+        return 0.0;
+    }
+
+    // make sure that the work on the last box is not counted against
+    // this one
+
+    Gpu::streamSynchronize();
+
+    return ParallelDescriptor::second();
+}
+
+void
+Castro::record_box_cost (const int box_index, const Real start_time)
+{
+    if (rebalance_int <= 0) {
+        return;
+    }
+
+    Gpu::streamSynchronize();
+
+    add_box_cost(box_index, ParallelDescriptor::second() - start_time);
+}
+
+void
+Castro::add_box_cost (const int box_index, const Real run_time)
+{
+    if (rebalance_int <= 0) {
+        return;
+    }
+
+    // with tiling, several threads may work on the same box
+
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+    box_cost[box_index] += run_time;
+}
+
+void
+Castro::rebalance (Amr* amr)
+{
+    BL_PROFILE("Castro::rebalance()");
+
+    const int nprocs = ParallelDescriptor::NProcs();
+
+    if (nprocs == 1) {
+        return;
+    }
+
+    for (int lev = 0; lev <= amr->finestLevel(); ++lev) {
+
+        Castro& castro_lev = dynamic_cast<Castro&>(amr->getLevel(lev));
+
+        const BoxArray& ba = amr->boxArray(lev);
+        const DistributionMapping& dm = amr->DistributionMap(lev);
+
+        // each rank only measured its own boxes, so the sum is the
+        // cost of every box
+
+        Vector<Real> cost(castro_lev.box_cost);
+        ParallelDescriptor::ReduceRealSum(cost.data(), static_cast<int>(cost.size()));
+
+        // start a new measurement
+
+        castro_lev.box_cost.assign(ba.size(), 0.0);
+
+        Vector<Real> rank_cost(nprocs, 0.0);
+        for (int i = 0; i < ba.size(); ++i) {
+            rank_cost[dm[i]] += cost[i];
+        }
+
+        Real max_cost = 0.0;
+        Real sum_cost = 0.0;
+        for (int n = 0; n < nprocs; ++n) {
+            max_cost = amrex::max(max_cost, rank_cost[n]);
+            sum_cost += rank_cost[n];
+        }
+
+        const Real avg_cost = sum_cost / static_cast<Real>(nprocs);
+
+        if (max_cost <= 0.0 || max_cost <= rebalance_threshold * avg_cost) {
+            continue;
+        }
+
+        const Real old_efficiency = avg_cost / max_cost;
+        Real new_efficiency = 0.0;
+
+        DistributionMapping new_dm;
+
+        if (rebalance_strategy == 1) {
+            new_dm = DistributionMapping::makeSFC(cost, ba, new_efficiency);
+        } else {
+            new_dm = DistributionMapping::makeKnapSack(cost, new_efficiency);
+        }
+
+        // moving the data is not free, so only do it if we gain
+        // something from it
+
+        const bool do_rebalance = new_efficiency > 1.05_rt * old_efficiency;
+
+        if (verbose > 0) {
+            amrex::Print() << "... level " << lev << " measured load balance efficiency "
+                           << old_efficiency << ", redistributed efficiency "
+                           << new_efficiency
+                           << (do_rebalance ? ": rebalancing" : ": keeping the distribution")
+                           << std::endl;
+        }
+
+        if (!do_rebalance) {
+            continue;
+        }
+
+#ifdef GRAVITY
+        // the gradient of phi is not state data, so the new level does
+        // not get it from init(old) -- hold on to the old one and copy
+        // it over
+
+        const bool move_grad_phi = do_grav && gravity->get_gravity_type() == "PoissonGrav";
+
+        Vector<std::unique_ptr<MultiFab>> grad_phi_prev;
+        Vector<std::unique_ptr<MultiFab>> grad_phi_curr;
+
+        if (move_grad_phi) {
+            std::swap(grad_phi_prev, gravity->get_grad_phi_prev(lev));
+            std::swap(grad_phi_curr, gravity->get_grad_phi_curr(lev));
+        }
+#endif
+
+        // this builds a new level on new_dm, fills its state data from
+        // the old level, and then deletes the old level.  The fluxes
+        // and flux registers of the new level are only used in the
+        // next timestep, so they are defined but not copied.
+
+        amr->InstallNewDistributionMap(lev, new_dm);
+
+#ifdef GRAVITY
+        if (move_grad_phi) {
+            const Geometry& geom_lev = amr->Geom(lev);
+            for (int n = 0; n < AMREX_SPACEDIM; ++n) {
+                gravity->get_grad_phi_prev(lev)[n]->ParallelCopy(*grad_phi_prev[n], 0, 0, 1, 1, 1, geom_lev.periodicity());
+                gravity->get_grad_phi_curr(lev)[n]->ParallelCopy(*grad_phi_curr[n], 0, 0, 1, 1, 1, geom_lev.periodicity());
+            }
+        }
+#endif
+
+        // the finer level keeps a mask on this level's distribution
+
+        if (lev < amr->finestLevel()) {
+            dynamic_cast<Castro&>(amr->getLevel(lev+1)).fine_mask.clear();
+        }
+
+#ifdef AMREX_PARTICLES
+        if (TracerPC) {
+            TracerPC->Redistribute(lev);
+        }
+#endif
+
+    }
+}
+
 MultiFab&
 Castro::build_fine_mask()
 {
@@ -64,6 +64,10 @@ Castro::advance (Real time,
         dt_new = do_advance_sdc(time, dt, amr_iteration, amr_ncycle);
       }
 
+    } else if (time_integration_method == LowStorageRungeKutta) {
+
+      dt_new = do_advance_lsrk(time, dt, amr_iteration, amr_ncycle);
+
 #endif // TRUE_SDC
 #endif // AMREX_USE_GPU
 #endif //MHD    
@@ -131,6 +135,19 @@ Castro::initialize_do_advance(Real time)
 
     cfl_violation = 0;
 
+    // We have not yet harvested the CFL timestep from this advance.
+
+    hydro_estdt_harvest_valid = false;
+
+#ifdef REACTIONS
+    // The burn statistics are for the last burn in this advance, so
+    // make sure that an advance without a burn does not plot stale data.
+
+    if (Burn_Stats_Type >= 0) {
+        get_new_data(Burn_Stats_Type).setVal(0.0);
+    }
+#endif
+
 #ifdef RADIATION
     // make sure these are filled to avoid check/plot file errors:
     if (do_radiation) {
@@ -183,9 +200,10 @@ Castro::initialize_do_advance(Real time)
       const Real prev_time = state[State_Type].prevTime();
       expand_state(Sborder, prev_time, NUM_GROW);
 
-    } else if (time_integration_method == SpectralDeferredCorrections) {
+    } else if (time_integration_method == SpectralDeferredCorrections ||
+               time_integration_method == LowStorageRungeKutta) {
 
-      // we'll handle the filling inside of do_advance_sdc 
+      // we'll handle the filling inside of do_advance_sdc / do_advance_lsrk
       Sborder.define(grids, dmap, NUM_STATE, NUM_GROW, MFInfo().SetTag("Sborder"));
 
     } else {
@@ -228,6 +246,12 @@ Castro::initialize_advance(Real time, Real dt, int amr_iteration, int amr_ncycle
 {
     BL_PROFILE("Castro::initialize_advance()");
 
+    // The state is going to change, so we can neither use nor add to
+    // the derive cache until the advance is done.
+
+    clear_derive_cache();
+    derive_cache_enabled = false;
+
     // Save the current iteration.
 
     iteration = amr_iteration;
@@ -380,6 +404,10 @@ Castro::initialize_advance(Real time, Real dt, int amr_iteration, int amr_ncycle
 #endif
 
     }
+
+    if (time_integration_method == LowStorageRungeKutta) {
+      lsrk_dU.define(grids, dmap, NUM_STATE, 0);
+    }
 #endif
 
     // Zero out the current fluxes.
@@ -412,6 +440,11 @@ Castro::finalize_advance()
 {
     BL_PROFILE("Castro::finalize_advance()");
 
+    clear_derive_cache();
+    derive_cache_enabled = true;
+
+    update_work_estimate();
+
     if (do_reflux) {
         FluxRegCrseInit();
         FluxRegFineAdd();
@@ -452,6 +485,10 @@ Castro::finalize_advance()
       Sburn.clear();
 #endif
     }
+
+    if (time_integration_method == LowStorageRungeKutta) {
+      lsrk_dU.clear();
+    }
 #endif
 
     // Record how many zones we have advanced.
@@ -275,6 +275,10 @@ Castro::do_advance_ctu(Real time,
 
     if (apply_sources()) {
 
+      // the new-time sources change the state after the hydro update
+
+      hydro_estdt_harvest_valid = false;
+
       do_new_sources(
 #ifdef MHD
                               Bx_new, By_new, Bz_new,
@@ -310,6 +314,8 @@ Castro::do_advance_ctu(Real time,
 
         if (do_react) {
 
+            hydro_estdt_harvest_valid = false;
+
             // store the current conserved state (without burning) into
             // Simplified_SDC_React_Type -- this will be used after the burn
             // to figure out just the effect of reactions
@@ -352,7 +358,31 @@ Castro::do_advance_ctu(Real time,
 
     if (time_integration_method != SimplifiedSpectralDeferredCorrections) {
 
-        burn_success = react_state(S_new, R_new, cur_time - 0.5 * dt, 0.5 * dt);
+        if (do_react) {
+            hydro_estdt_harvest_valid = false;
+        }
+
+        // Keep the rates from this burn for the burning limited
+        // timestep.  This is the last burn before the timestep is
+        // estimated, so they describe the new-time state.
+
+        MultiFab* rates = nullptr;
+
+        if (estdt_burning_from_burn == 1) {
+            if (!burn_rates.ok() || burn_rates.boxArray() != S_new.boxArray() ||
+                burn_rates.DistributionMap() != S_new.DistributionMap()) {
+                burn_rates.define(S_new.boxArray(), S_new.DistributionMap(), NumSpec + 2, 0);
+            }
+            rates = &burn_rates;
+            burn_rates_time = -1.e200;
+        }
+
+        burn_success = react_state(S_new, R_new, cur_time - 0.5 * dt, 0.5 * dt, rates);
+
+        if (burn_success && rates != nullptr) {
+            burn_rates_time = cur_time;
+        }
+
         clean_state(
 #ifdef MHD
                     Bx_new, By_new, Bz_new,
@@ -0,0 +1,150 @@
+#include <Castro.H>
+#include <Castro_F.H>
+
+#ifdef GRAVITY
+#include <Gravity.H>
+#endif
+
+#include <cmath>
+#include <climits>
+
+using std::string;
+using namespace amrex;
+
+#ifndef MHD
+#ifndef AMREX_USE_GPU
+Real
+Castro::do_advance_lsrk (Real time,
+                         Real dt,
+                         int  amr_iteration,
+                         int  amr_ncycle)
+{
+
+  // this is a 2N-storage low-storage Runge-Kutta integration of the
+  // method-of-lines hydro update.  At each stage s we do
+  //
+  //   dU = A_s dU + L(U)
+  //    U = U + B_s dt dU
+  //
+  // where L is the hydro source (the flux divergence plus the
+  // old-time sources) evaluated at t + c_s dt.  S_new carries U and
+  // lsrk_dU carries dU, so we only need these two registers no matter
+  // how many stages the method has.
+
+  BL_PROFILE("Castro::do_advance_lsrk()");
+
+  const Real prev_time = state[State_Type].prevTime();
+  const Real  cur_time = state[State_Type].curTime();
+
+  MultiFab& S_old = get_old_data(State_Type);
+  MultiFab& S_new = get_new_data(State_Type);
+
+  // Perform initialization steps.
+
+  initialize_do_advance(time);
+
+  // Check for NaN's.
+
+  check_for_nan(S_old);
+
+  MultiFab& old_source = get_old_data(Source_Type);
+  MultiFab& new_source = get_new_data(Source_Type);
+
+  bool apply_sources_to_state = false;
+
+  // we start from the old state
+
+  MultiFab::Copy(S_new, S_old, 0, 0, S_new.nComp(), 0);
+
+  const int nstages = static_cast<int>(lsrk_A.size());
+
+  for (int s = 0; s < nstages; ++s) {
+
+    current_lsrk_stage = s;
+
+    Real stage_time = time + lsrk_c[s] * dt;
+
+    // fill Sborder with the current stage's state.  As with SDC, we
+    // pass cur_time to the FillPatch so it only pulls from S_new --
+    // this will not work for multilevel.
+    if (s > 0) {
+      clean_state(S_new, cur_time, 0);
+    }
+    expand_state(Sborder, cur_time, NUM_GROW);
+
+    // Construct the "old-time" sources from Sborder, which evaluates
+    // them using the stage's state.
+
+#ifdef GRAVITY
+    construct_old_gravity(amr_iteration, amr_ncycle, prev_time);
+#endif
+
+    if (apply_sources()) {
+
+      // there is a ghost cell fill hidden in diffusion, so we need
+      // to pass in the time associate with Sborder
+      do_old_sources(old_source, Sborder, Sborder, cur_time, dt, apply_sources_to_state);
+
+      // the sources are only used in the valid box, except for the
+      // well-balanced reconstruction of the pressure
+      if (use_pslope == 1) {
+        AmrLevel::FillPatch(*this, old_source, old_source.nGrow(), prev_time, Source_Type, 0, NSRC);
+      }
+
+    }
+
+    // Construct the primitive variables.
+    cons_to_prim(stage_time);
+
+    if (do_hydro) {
+      // Check for CFL violations.
+      check_for_cfl_violation(S_new, dt);
+
+      // If we detect one, return immediately.
+      if (cfl_violation)
+        return dt;
+    }
+
+    // dU = A_s dU + L(U).  construct_mol_hydro_source adds the stage
+    // rate into its argument, so we scale the register in place
+    // first (A_0 = 0, so the first stage just starts from zero).
+    if (s == 0) {
+      lsrk_dU.setVal(0.0);
+    } else {
+      lsrk_dU.mult(lsrk_A[s]);
+    }
+
+    construct_mol_hydro_source(stage_time, dt, lsrk_dU);
+
+    // U = U + B_s dt dU
+    MultiFab::Saxpy(S_new, lsrk_B[s] * dt, lsrk_dU, 0, 0, S_new.nComp(), 0);
+
+  }
+
+  // We need to make source_old and source_new be the source terms at
+  // the old and new time.  The last stage sources are at an
+  // intermediate time, so we evaluate them again here.
+
+  clean_state(S_old, prev_time, 0);
+  expand_state(Sborder, prev_time, Sborder.nGrow());
+  do_old_sources(old_source, Sborder, Sborder, prev_time, dt, apply_sources_to_state);
+  AmrLevel::FillPatch(*this, old_source, old_source.nGrow(), prev_time, Source_Type, 0, NSRC);
+
+  clean_state(S_new, cur_time, 0);
+  expand_state(Sborder, cur_time, Sborder.nGrow());
+  do_old_sources(new_source, Sborder, Sborder, cur_time, dt, apply_sources_to_state);
+  AmrLevel::FillPatch(*this, new_source, new_source.nGrow(), cur_time, Source_Type, 0, NSRC);
+
+#ifdef REACTIONS
+  // there are no reactions in this advance, but the reaction data is
+  // still written to the plotfile
+  get_new_data(Reactions_Type).setVal(0.0);
+#endif
+
+  finalize_do_advance();
+
+  return dt;
+}
+
+#endif
+#endif
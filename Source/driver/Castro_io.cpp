@@ -496,6 +496,12 @@ Castro::setPlotVariables ()
     parent->deleteStatePlotVar(desc_lst[Source_Type].name(i));
   }
 
+  // nor the work estimate, which is only used for load balancing
+
+  if (Work_Estimate_Type >= 0) {
+    parent->deleteStatePlotVar(desc_lst[Work_Estimate_Type].name(0));
+  }
+
 #ifdef SIMPLIFIED_SDC
 #ifdef REACTIONS
   if (time_integration_method == SimplifiedSpectralDeferredCorrections) {
@@ -1126,8 +1132,8 @@ Castro::plotFileOutput(const std::string& dir,
             if ((parent->isDerivePlotVar(it->name()) && is_small == 0) || 
                 (parent->isDeriveSmallPlotVar(it->name()) && is_small == 1)) {
 
-                auto derive_dat = derive(it->variableName(0), cur_time, nGrow);
-                MultiFab::Copy(plotMF, *derive_dat, 0, cnt, it->numDerive(), nGrow);
+                const MultiFab& derive_dat = derive_cached(it->variableName(0), cur_time, nGrow);
+                MultiFab::Copy(plotMF, derive_dat, 0, cnt, it->numDerive(), nGrow);
                 cnt = cnt + it->numDerive();
 
             }
@@ -312,7 +312,8 @@ Castro::variableSetUp ()
 #ifdef MHD
   NUM_GROW_SRC = 6;
 #else
-  if (time_integration_method == SpectralDeferredCorrections) {
+  if (time_integration_method == SpectralDeferredCorrections ||
+      time_integration_method == LowStorageRungeKutta) {
       NUM_GROW_SRC = NUM_GROW;
   } else {
       NUM_GROW_SRC = 3;
@@ -433,7 +434,8 @@ Castro::variableSetUp ()
   if (time_integration_method == CornerTransportUpwind || time_integration_method == SimplifiedSpectralDeferredCorrections) {
       source_ng = NUM_GROW_SRC;
   }
-  else if (time_integration_method == SpectralDeferredCorrections) {
+  else if (time_integration_method == SpectralDeferredCorrections ||
+           time_integration_method == LowStorageRungeKutta) {
     if (sdc_order == 2 && use_pslope) {
       source_ng = NUM_GROW_SRC;
     } else {
@@ -752,6 +754,47 @@ Castro::variableSetUp ()
   }
 #endif
 
+  // the work estimate used for load balancing is also optional.  It
+  // is rebuilt after every advance, so it is not stored in the
+  // checkpoint, and we interpolate it as piecewise constant, since
+  // each fine zone costs as much as its parent coarse zone.
+
+  if (load_balance_with_work_estimates == 1) {
+
+    Work_Estimate_Type = desc_lst.size();
+
+    store_in_checkpoint = false;
+    desc_lst.addDescriptor(Work_Estimate_Type, IndexType::TheCellType(),
+                           StateDescriptor::Point, 0, 1,
+                           &pc_interp, state_data_extrap, store_in_checkpoint);
+
+    set_scalar_bc(bc, phys_bc);
+    replace_inflow_bc(bc);
+    desc_lst.setComponent(Work_Estimate_Type, 0, "work_estimate", bc, genericBndryFunc);
+  }
+
+#ifdef REACTIONS
+  // the statistics of the last burn in each zone, for the plotfile.
+  // These are only diagnostics, so they are not stored in the
+  // checkpoint.
+
+  if (react_stats_plot == 1) {
+
+    Burn_Stats_Type = desc_lst.size();
+
+    store_in_checkpoint = false;
+    desc_lst.addDescriptor(Burn_Stats_Type, IndexType::TheCellType(),
+                           StateDescriptor::Point, 0, 3,
+                           &pc_interp, state_data_extrap, store_in_checkpoint);
+
+    set_scalar_bc(bc, phys_bc);
+    replace_inflow_bc(bc);
+    desc_lst.setComponent(Burn_Stats_Type, 0, "burn_n_rhs", bc, genericBndryFunc);
+    desc_lst.setComponent(Burn_Stats_Type, 1, "burn_n_jac", bc, genericBndryFunc);
+    desc_lst.setComponent(Burn_Stats_Type, 2, "burn_status", bc, genericBndryFunc);
+  }
+#endif
+
   num_state_type = desc_lst.size();
 
   //
@@ -1192,6 +1235,59 @@ Castro::variableSetUp ()
   } else {
     amrex::Error("invalid value of sdc_quadrature");
   }
+
+  if (time_integration_method == LowStorageRungeKutta) {
+
+    if (lsrk_order == 3) {
+      // Williamson (1980), 3 stages
+
+      lsrk_A = {0.0, -5.0/9.0, -153.0/128.0};
+      lsrk_B = {1.0/3.0, 15.0/16.0, 8.0/15.0};
+      lsrk_c = {0.0, 1.0/3.0, 3.0/4.0};
+
+    } else if (lsrk_order == 4) {
+      // Carpenter & Kennedy (1994), 5 stages
+
+      lsrk_A = {0.0,
+                -567301805773.0/1357537059087.0,
+                -2404267990393.0/2016746695238.0,
+                -3550918686646.0/2091501179385.0,
+                -1275806237668.0/842570457699.0};
+      lsrk_B = {1432997174477.0/9575080441755.0,
+                5161836677717.0/13612068292357.0,
+                1720146321549.0/2090206949498.0,
+                3134564353537.0/4481467310338.0,
+                2277821191437.0/14882151754819.0};
+      lsrk_c = {0.0,
+                1432997174477.0/9575080441755.0,
+                2526269341429.0/6820363962896.0,
+                2006345519317.0/3224310063776.0,
+                2802321613138.0/2924317926251.0};
+
+    } else {
+      amrex::Error("invalid value of lsrk_order");
+    }
+
+    // unroll the recurrence to find the weight of each stage's rate
+    // in the final update, U^{n+1} = U^n + dt sum_s w_s L_s.  The
+    // coefficient of L_r in dU after stage s is d_r.
+
+    const int nstages = static_cast<int>(lsrk_A.size());
+
+    Vector<Real> d(nstages, 0.0);
+    lsrk_weights.assign(nstages, 0.0);
+
+    for (int s = 0; s < nstages; ++s) {
+      for (int r = 0; r < s; ++r) {
+        d[r] *= lsrk_A[s];
+      }
+      d[s] = 1.0;
+      for (int r = 0; r <= s; ++r) {
+        lsrk_weights[r] += lsrk_B[s] * d[r];
+      }
+    }
+
+  }
 #endif
 
 }
@@ -0,0 +1,66 @@
+#include <derive_cache.H>
+
+#include <AMReX_ParallelDescriptor.H>
+
+using namespace amrex;
+
+const MultiFab*
+DeriveCache::find (const std::string& name, const Real time, const int ngrow)
+{
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        if (it->name == name && it->time == time && it->ngrow >= ngrow) {
+            // move it to the front of the list
+            m_entries.splice(m_entries.begin(), m_entries, it);
+            return m_entries.front().mf.get();
+        }
+    }
+
+    return nullptr;
+}
+
+const MultiFab&
+DeriveCache::insert (const std::string& name, const Real time, const int ngrow,
+                     std::unique_ptr<MultiFab>&& mf, const Long max_bytes)
+{
+    BL_ASSERT(mf);
+
+    // the size of the data on the grown boxes, averaged over the ranks.
+    // We use the BoxArray so that this is the same on every rank.
+
+    const BoxArray& ba = mf->boxArray();
+    Long npts = 0;
+    for (int i = 0; i < ba.size(); ++i) {
+        npts += amrex::grow(ba[i], mf->nGrowVect()).numPts();
+    }
+
+    const Long bytes = npts * mf->nComp() * static_cast<Long>(sizeof(Real)) /
+                       ParallelDescriptor::NProcs();
+
+    // replace any older copy with fewer ghost cells
+
+    for (auto it = m_entries.begin(); it != m_entries.end(); ) {
+        if (it->name == name && it->time == time) {
+            m_bytes -= it->bytes;
+            it = m_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    while (!m_entries.empty() && m_bytes + bytes > max_bytes) {
+        m_bytes -= m_entries.back().bytes;
+        m_entries.pop_back();
+    }
+
+    m_entries.push_front(Entry{name, time, ngrow, bytes, std::move(mf)});
+    m_bytes += bytes;
+
+    return *m_entries.front().mf;
+}
+
+void
+DeriveCache::clear ()
+{
+    m_entries.clear();
+    m_bytes = 0;
+}
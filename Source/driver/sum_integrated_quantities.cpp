@@ -48,37 +48,66 @@ Castro::sum_integrated_quantities ()
     int fixwidth     = 25; // Floating point data not in scientific notation
     int intwidth     = 12; // Integer data
 
+    // All of the volume integrals on a level are done in a single pass
+    // over the state.
+
+    Vector<int> quantities = {vs_mass, vs_xmom, vs_ymom, vs_zmom,
+                              vs_angmom_x, vs_angmom_y, vs_angmom_z,
+#ifdef HYBRID_MOMENTUM
+                              vs_rmom, vs_lmom, vs_zmom,
+#endif
+                              vs_rho_e, vs_rho_K, vs_rho_E};
+
+    if (show_center_of_mass) {
+        quantities.push_back(vs_mass_x);
+        quantities.push_back(vs_mass_y);
+        quantities.push_back(vs_mass_z);
+    }
+
+#ifdef GRAVITY
+    const bool do_rho_phi = gravity->get_gravity_type() == "PoissonGrav";
+    if (do_rho_phi) {
+        quantities.push_back(vs_rho_phi_grav);
+    }
+#endif
+
     for (int lev = 0; lev <= finest_level; lev++)
     {
         Castro& ca_lev = getLevel(lev);
 
-        mass   += ca_lev.volWgtSum("density", time, local_flag);
-        mom[0] += ca_lev.volWgtSum("xmom", time, local_flag);
-        mom[1] += ca_lev.volWgtSum("ymom", time, local_flag);
-        mom[2] += ca_lev.volWgtSum("zmom", time, local_flag);
+        Vector<Real> sums = ca_lev.volWgtSums(quantities, time, local_flag);
 
-        ang_mom[0] += ca_lev.volWgtSum("angular_momentum_x", time, local_flag);
-        ang_mom[1] += ca_lev.volWgtSum("angular_momentum_y", time, local_flag);
-        ang_mom[2] += ca_lev.volWgtSum("angular_momentum_z", time, local_flag);
+        int n = 0;
+
+        mass       += sums[n++];
+        mom[0]     += sums[n++];
+        mom[1]     += sums[n++];
+        mom[2]     += sums[n++];
+
+        ang_mom[0] += sums[n++];
+        ang_mom[1] += sums[n++];
+        ang_mom[2] += sums[n++];
 
 #ifdef HYBRID_MOMENTUM
-        hyb_mom[0] += ca_lev.volWgtSum("rmom", time, local_flag);
-        hyb_mom[1] += ca_lev.volWgtSum("lmom", time, local_flag);
-        hyb_mom[2] += ca_lev.volWgtSum("zmom", time, local_flag);
+        hyb_mom[0] += sums[n++];
+        hyb_mom[1] += sums[n++];
+        hyb_mom[2] += sums[n++];
 #endif
 
+        rho_e      += sums[n++];
+        rho_K      += sums[n++];
+        rho_E      += sums[n++];
+
         if (show_center_of_mass) {
-           com[0] += ca_lev.locWgtSum("density", time, 0, local_flag);
-           com[1] += ca_lev.locWgtSum("density", time, 1, local_flag);
-           com[2] += ca_lev.locWgtSum("density", time, 2, local_flag);
+            com[0] += sums[n++];
+            com[1] += sums[n++];
+            com[2] += sums[n++];
         }
 
-       rho_e += ca_lev.volWgtSum("rho_e", time, local_flag);
-       rho_K += ca_lev.volWgtSum("kineng", time, local_flag);
-       rho_E += ca_lev.volWgtSum("rho_E", time, local_flag);
 #ifdef GRAVITY
-        if (gravity->get_gravity_type() == "PoissonGrav")
-               rho_phi += ca_lev.volProductSum("density", "phiGrav", time, local_flag);
+        if (do_rho_phi) {
+            rho_phi += sums[n++];
+        }
 #endif
 
     }
@@ -88,15 +117,15 @@ Castro::sum_integrated_quantities ()
 
 #ifdef HYBRID_MOMENTUM
 #ifdef GRAVITY
-       const int nfoo = 14;
+       const int nfoo = 17;
 #else
-       const int nfoo = 13;
+       const int nfoo = 16;
 #endif
 #else
 #ifdef GRAVITY
-       const int nfoo = 11;
+       const int nfoo = 14;
 #else
-       const int nfoo = 10;
+       const int nfoo = 13;
 #endif
 #endif
 
@@ -104,6 +133,7 @@ Castro::sum_integrated_quantities ()
 #ifdef HYBRID_MOMENTUM
                           hyb_mom[0], hyb_mom[1], hyb_mom[2],
 #endif
+                          com[0], com[1], com[2],
 #ifdef GRAVITY
                           rho_e, rho_K, rho_E, rho_phi};
 #else
@@ -116,9 +146,6 @@ Castro::sum_integrated_quantities ()
 
         ParallelDescriptor::ReduceRealSum(foo, nfoo, ParallelDescriptor::IOProcessorNumber());
 
-        if (show_center_of_mass)
-            ParallelDescriptor::ReduceRealSum(com, 3, ParallelDescriptor::IOProcessorNumber());
-
         if (ParallelDescriptor::IOProcessor()) {
 
             int i = 0;
@@ -134,6 +161,9 @@ Castro::sum_integrated_quantities ()
             hyb_mom[1] = foo[i++];
             hyb_mom[2] = foo[i++];
 #endif
+            com[0]     = foo[i++];
+            com[1]     = foo[i++];
+            com[2]     = foo[i++];
             rho_e      = foo[i++];
             rho_K      = foo[i++];
             rho_E      = foo[i++];
@@ -3,6 +3,7 @@
 #include <Castro.H>
 #include <Castro_F.H>
 #include <Castro_util.H>
+#include <math.H>
 
 #ifdef GRAVITY
 #include <Gravity.H>
@@ -23,14 +24,15 @@ Castro::volWgtSum (const std::string& name,
 {
     BL_PROFILE("Castro::volWgtSum()");
 
-    auto mf = derive(name, time, 0);
+    // we only read the derived data, so it can come from the derive cache
 
-    BL_ASSERT(mf);
+    const MultiFab& mf = derive_cached(name, time, 0);
 
-    if (level < parent->finestLevel() && finemask)
-    {
-        const MultiFab& mask = getLevel(level+1).build_fine_mask();
-        MultiFab::Multiply(*mf, mask, 0, 0, 1, 0);
+    // zones covered by the finer level are masked out
+
+    const MultiFab* mask = nullptr;
+    if (level < parent->finestLevel() && finemask) {
+        mask = &getLevel(level+1).build_fine_mask();
     }
 
     ReduceOps<ReduceOpSum> reduce_op;
@@ -40,9 +42,11 @@ Castro::volWgtSum (const std::string& name,
 #ifdef _OPENMP
 #pragma omp parallel
 #endif    
-    for (MFIter mfi(*mf, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    for (MFIter mfi(mf, TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
-        auto const& fab = (*mf).array(mfi);
+        auto const& fab = mf.const_array(mfi);
+        auto const& msk = mask != nullptr ? mask->const_array(mfi) : Array4<Real const>{};
+        const bool use_mask = mask != nullptr;
         auto const& vol = volume.array(mfi);
 
         const Box& box = mfi.tilebox();
@@ -55,7 +59,9 @@ Castro::volWgtSum (const std::string& name,
         reduce_op.eval(box, reduce_data,
         [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> ReduceTuple
         {
-            return {fab(i,j,k) * vol(i,j,k)};
+            const Real q = use_mask ? fab(i,j,k) * msk(i,j,k) : fab(i,j,k);
+
+            return {q * vol(i,j,k)};
         });
 
     }
@@ -69,6 +75,274 @@ Castro::volWgtSum (const std::string& name,
     return sum;
 }
 
+namespace {
+
+    // the value of a single vol_sum_quantity in zone (i,j,k), per unit volume
+
+    AMREX_GPU_HOST_DEVICE AMREX_INLINE
+    Real
+    vol_sum_zone (const int quantity, const int i, const int j, const int k,
+                  Array4<Real const> const& U,
+                  Array4<Real const> const& phigrav,
+                  Array4<Real const> const& phirot,
+                  GpuArray<Real, AMREX_SPACEDIM> const& dx,
+                  GpuArray<Real, AMREX_SPACEDIM> const& problo,
+                  GeometryData const& geomdata,
+                  const Real time)
+    {
+        amrex::ignore_unused(phigrav, phirot, geomdata, time);
+
+        // the zone center, measured from the lower corner of the domain
+
+        GpuArray<Real, 3> pos;
+
+        pos[0] = problo[0] + (0.5_rt + i) * dx[0];
+#if AMREX_SPACEDIM >= 2
+        pos[1] = problo[1] + (0.5_rt + j) * dx[1];
+#else
+        pos[1] = 0.0_rt;
+#endif
+#if AMREX_SPACEDIM == 3
+        pos[2] = problo[2] + (0.5_rt + k) * dx[2];
+#else
+        pos[2] = 0.0_rt;
+#endif
+
+        const Real rho = U(i,j,k,URHO);
+        GpuArray<Real, 3> mom{U(i,j,k,UMX), U(i,j,k,UMY), U(i,j,k,UMZ)};
+
+        switch (quantity) {
+
+        case vs_mass:
+            return rho;
+
+        case vs_xmom:
+        case vs_ymom:
+        case vs_zmom:
+            return mom[quantity - vs_xmom];
+
+        case vs_angmom_x:
+        case vs_angmom_y:
+        case vs_angmom_z:
+        case vs_inertial_mom_x:
+        case vs_inertial_mom_y:
+        case vs_inertial_mom_z:
+        case vs_inertial_angmom_x:
+        case vs_inertial_angmom_y:
+        case vs_inertial_angmom_z:
+        {
+            GpuArray<Real, 3> loc;
+            for (int dir = 0; dir < 3; ++dir) {
+                loc[dir] = pos[dir];
+            }
+            for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+                loc[dir] -= problem::center[dir];
+            }
+
+            if (quantity <= vs_angmom_z) {
+                GpuArray<Real, 3> L;
+                cross_product(loc, mom, L);
+                return L[quantity - vs_angmom_x];
+            }
+
+            GpuArray<Real, 3> inertial_vel{mom[0] / rho, mom[1] / rho, mom[2] / rho};
+#ifdef ROTATION
+            rotational_to_inertial_velocity(i, j, k, geomdata, time, inertial_vel);
+#endif
+
+            if (quantity <= vs_inertial_mom_z) {
+                return rho * inertial_vel[quantity - vs_inertial_mom_x];
+            }
+
+            GpuArray<Real, 3> angular_vel;
+            cross_product(loc, inertial_vel, angular_vel);
+            return rho * angular_vel[quantity - vs_inertial_angmom_x];
+        }
+
+#ifdef HYBRID_MOMENTUM
+        case vs_rmom:
+            return U(i,j,k,UMR);
+
+        case vs_lmom:
+            return U(i,j,k,UML);
+
+        case vs_pmom:
+            return U(i,j,k,UMP);
+#endif
+
+        case vs_mass_x:
+        case vs_mass_y:
+        case vs_mass_z:
+            return rho * pos[quantity - vs_mass_x];
+
+        case vs_rho_e:
+            return U(i,j,k,UEINT);
+
+        case vs_rho_K:
+            return 0.5_rt / rho * (mom[0] * mom[0] + mom[1] * mom[1] + mom[2] * mom[2]);
+
+        case vs_rho_E:
+            return U(i,j,k,UEDEN);
+
+#ifdef GRAVITY
+        case vs_rho_phi_grav:
+            return rho * phigrav(i,j,k);
+#endif
+
+#ifdef ROTATION
+        case vs_rho_phi_rot:
+            return rho * phirot(i,j,k);
+#endif
+
+        default:
+            return 0.0_rt;
+
+        }
+    }
+
+}
+
+Vector<Real>
+Castro::volWgtSums (const Vector<int>& quantities,
+                    Real time,
+                    bool local)
+{
+    BL_PROFILE("Castro::volWgtSums()");
+
+    const int nq = quantities.size();
+
+    Vector<Real> sums(nq, 0.0_rt);
+
+    if (nq == 0) {
+        return sums;
+    }
+
+    AMREX_ALWAYS_ASSERT(nq <= num_vol_sum_quantities);
+
+    GpuArray<int, num_vol_sum_quantities> q_list{};
+    bool need_phigrav = false;
+    bool need_phirot = false;
+
+    for (int n = 0; n < nq; ++n) {
+        AMREX_ALWAYS_ASSERT(quantities[n] >= 0 && quantities[n] < num_vol_sum_quantities);
+        q_list[n] = quantities[n];
+#ifdef GRAVITY
+        need_phigrav = need_phigrav || quantities[n] == vs_rho_phi_grav;
+#endif
+#ifdef ROTATION
+        need_phirot = need_phirot || quantities[n] == vs_rho_phi_rot;
+#endif
+    }
+
+    // The diagnostics are only ever needed at the old or new time, so
+    // unlike derive() we don't interpolate the state in time.
+
+    const bool use_new = std::abs(time - state[State_Type].curTime()) <=
+                         std::abs(time - state[State_Type].prevTime());
+
+    const MultiFab& S = use_new ? get_new_data(State_Type) : get_old_data(State_Type);
+
+    const MultiFab* phigrav_mf = nullptr;
+    const MultiFab* phirot_mf = nullptr;
+
+#ifdef GRAVITY
+    if (need_phigrav) {
+        phigrav_mf = use_new ? &get_new_data(PhiGrav_Type) : &get_old_data(PhiGrav_Type);
+    }
+#endif
+#ifdef ROTATION
+    if (need_phirot) {
+        phirot_mf = use_new ? &get_new_data(PhiRot_Type) : &get_old_data(PhiRot_Type);
+    }
+#endif
+    amrex::ignore_unused(need_phigrav, need_phirot);
+
+    const MultiFab* mask_mf = nullptr;
+    if (level < parent->finestLevel()) {
+        mask_mf = &getLevel(level+1).build_fine_mask();
+    }
+
+    auto dx     = geom.CellSizeArray();
+    auto problo = geom.ProbLoArray();
+    GeometryData geomdata = geom.data();
+
+    // As in gwstrain, we accumulate into a small FArrayBox (with one
+    // copy per thread for OpenMP), one entry per quantity.
+
+    Box bx(IntVect(D_DECL(0, 0, 0)), IntVect(D_DECL(nq - 1, 0, 0)));
+
+    FArrayBox qsum(bx);
+    qsum.setVal<RunOn::Device>(0.0);
+
+#ifdef _OPENMP
+    int nthreads = omp_get_max_threads();
+    Vector< std::unique_ptr<FArrayBox> > priv_qsum(nthreads);
+    for (int i = 0; i < nthreads; i++) {
+        priv_qsum[i].reset(new FArrayBox(bx));
+    }
+#pragma omp parallel
+#endif
+    {
+#ifdef _OPENMP
+        int tid = omp_get_thread_num();
+        priv_qsum[tid]->setVal<RunOn::Device>(0.0);
+        auto qsum_arr = priv_qsum[tid]->array();
+#else
+        auto qsum_arr = qsum.array();
+#endif
+
+        for (MFIter mfi(S, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& box = mfi.tilebox();
+
+            auto const U = S.const_array(mfi);
+            auto const vol = volume.const_array(mfi);
+
+            Array4<Real const> const phigrav = phigrav_mf ? phigrav_mf->const_array(mfi) : Array4<Real const>{};
+            Array4<Real const> const phirot = phirot_mf ? phirot_mf->const_array(mfi) : Array4<Real const>{};
+            Array4<Real const> const mask = mask_mf ? mask_mf->const_array(mfi) : Array4<Real const>{};
+            const bool use_mask = mask_mf != nullptr;
+
+            amrex::ParallelFor(box,
+            [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+            {
+                Real dV = vol(i,j,k);
+                if (use_mask) {
+                    dV *= mask(i,j,k);
+                }
+
+                if (dV == 0.0_rt) {
+                    return;
+                }
+
+                for (int n = 0; n < nq; ++n) {
+                    Real dq = vol_sum_zone(q_list[n], i, j, k, U, phigrav, phirot,
+                                           dx, problo, geomdata, time) * dV;
+                    Gpu::Atomic::Add(&qsum_arr(n,0,0), dq);
+                }
+            });
+        }
+    }
+
+    Gpu::synchronize();
+
+    const Real* p = qsum.dataPtr();
+    for (int n = 0; n < nq; ++n) {
+        sums[n] = p[n];
+#ifdef _OPENMP
+        for (int it = 0; it < nthreads; it++) {
+            sums[n] += priv_qsum[it]->dataPtr()[n];
+        }
+#endif
+    }
+
+    if (!local) {
+        ParallelDescriptor::ReduceRealSum(sums.dataPtr(), nq);
+    }
+
+    return sums;
+}
+
 Real
 Castro::volWgtSquaredSum (const std::string& name,
                           Real               time,
@@ -76,14 +350,15 @@ Castro::volWgtSquaredSum (const std::string& name,
 {
     BL_PROFILE("Castro::volWgtSquaredSum()");
 
-    auto mf = derive(name, time, 0);
+    // we only read the derived data, so it can come from the derive cache
 
-    BL_ASSERT(mf);
+    const MultiFab& mf = derive_cached(name, time, 0);
 
-    if (level < parent->finestLevel())
-    {
-        const MultiFab& mask = getLevel(level+1).build_fine_mask();
-        MultiFab::Multiply(*mf, mask, 0, 0, 1, 0);
+    // zones covered by the finer level are masked out
+
+    const MultiFab* mask = nullptr;
+    if (level < parent->finestLevel()) {
+        mask = &getLevel(level+1).build_fine_mask();
     }
 
     ReduceOps<ReduceOpSum> reduce_op;
@@ -93,9 +368,11 @@ Castro::volWgtSquaredSum (const std::string& name,
 #ifdef _OPENMP
 #pragma omp parallel
 #endif    
-    for (MFIter mfi(*mf, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    for (MFIter mfi(mf, TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
-        auto const& fab = (*mf).array(mfi);
+        auto const& fab = mf.const_array(mfi);
+        auto const& msk = mask != nullptr ? mask->const_array(mfi) : Array4<Real const>{};
+        const bool use_mask = mask != nullptr;
         auto const& vol = volume.array(mfi);
     
         const Box& box = mfi.tilebox();
@@ -108,7 +385,9 @@ Castro::volWgtSquaredSum (const std::string& name,
         reduce_op.eval(box, reduce_data,
         [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> ReduceTuple
         {
-            return {fab(i,j,k) * fab(i,j,k) * vol(i,j,k)};
+            const Real q = use_mask ? fab(i,j,k) * msk(i,j,k) : fab(i,j,k);
+
+            return {q * q * vol(i,j,k)};
         });
 
     }
@@ -130,14 +409,15 @@ Castro::locWgtSum (const std::string& name,
 {
     BL_PROFILE("Castro::locWgtSum()");
 
-    auto mf = derive(name, time, 0);
+    // we only read the derived data, so it can come from the derive cache
 
-    BL_ASSERT(mf);
+    const MultiFab& mf = derive_cached(name, time, 0);
 
-    if (level < parent->finestLevel())
-    {
-        const MultiFab& mask = getLevel(level+1).build_fine_mask();
-        MultiFab::Multiply(*mf, mask, 0, 0, 1, 0);
+    // zones covered by the finer level are masked out
+
+    const MultiFab* mask = nullptr;
+    if (level < parent->finestLevel()) {
+        mask = &getLevel(level+1).build_fine_mask();
     }
 
     ReduceOps<ReduceOpSum> reduce_op;
@@ -150,9 +430,12 @@ Castro::locWgtSum (const std::string& name,
 #ifdef _OPENMP
 #pragma omp parallel
 #endif    
-    for (MFIter mfi(*mf, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    for (MFIter mfi(mf, TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
-        auto const& fab = (*mf).array(mfi);
+        auto const& fab = mf.const_array(mfi);
+        auto const& vol = volume.array(mfi);
+        auto const& msk = mask != nullptr ? mask->const_array(mfi) : Array4<Real const>{};
+        const bool use_mask = mask != nullptr;
     
         const Box& box = mfi.tilebox();
 
@@ -164,6 +447,8 @@ Castro::locWgtSum (const std::string& name,
         reduce_op.eval(box, reduce_data,
         [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> ReduceTuple
         {
+            const Real q = (use_mask ? fab(i,j,k) * msk(i,j,k) : fab(i,j,k)) * vol(i,j,k);
+
             Real loc[3];
 
             loc[0] = problo[0] + (0.5_rt + i) * dx[0];
@@ -183,13 +468,13 @@ Castro::locWgtSum (const std::string& name,
             Real ds;
 
             if (idir == 0) { // sum(mass * x)
-                ds = fab(i,j,k) * loc[0];
+                ds = q * loc[0];
             }
             else if (idir == 1) { // sum(mass * y)
-                ds = fab(i,j,k) * loc[1];
+                ds = q * loc[1];
             }
             else { // sum(mass * z)
-                ds = fab(i,j,k) * loc[2];
+                ds = q * loc[2];
             }
 
             return {ds};
@@ -264,14 +549,15 @@ Castro::locSquaredSum (const std::string& name,
 {
     BL_PROFILE("Castro::locSquaredSum()");
 
-    auto mf = derive(name, time, 0);
+    // we only read the derived data, so it can come from the derive cache
 
-    BL_ASSERT(mf);
+    const MultiFab& mf = derive_cached(name, time, 0);
 
-    if (level < parent->finestLevel())
-    {
-        const MultiFab& mask = getLevel(level+1).build_fine_mask();
-        MultiFab::Multiply(*mf, mask, 0, 0, 1, 0);
+    // zones covered by the finer level are masked out
+
+    const MultiFab* mask = nullptr;
+    if (level < parent->finestLevel()) {
+        mask = &getLevel(level+1).build_fine_mask();
     }
 
     ReduceOps<ReduceOpSum> reduce_op;
@@ -284,15 +570,19 @@ Castro::locSquaredSum (const std::string& name,
 #ifdef _OPENMP
 #pragma omp parallel
 #endif    
-    for (MFIter mfi(*mf, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    for (MFIter mfi(mf, TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
-        auto const& fab = (*mf).array(mfi);
+        auto const& fab = mf.const_array(mfi);
+        auto const& msk = mask != nullptr ? mask->const_array(mfi) : Array4<Real const>{};
+        const bool use_mask = mask != nullptr;
     
         const Box& box = mfi.tilebox();
 
         reduce_op.eval(box, reduce_data,
         [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> ReduceTuple
         {
+            const Real q = use_mask ? fab(i,j,k) * msk(i,j,k) : fab(i,j,k);
+
             Real loc[3];
 
             loc[0] = problo[0] + (0.5_rt + i) * dx[0];
@@ -312,16 +602,16 @@ Castro::locSquaredSum (const std::string& name,
             Real ds;
 
             if (idir == 0) { // sum(mass * x^2)
-                ds = fab(i,j,k) * loc[0] * loc[0];
+                ds = q * loc[0] * loc[0];
             }
             else if (idir == 1) { // sum(mass * y^2)
-                ds = fab(i,j,k) * loc[1] * loc[1];
+                ds = q * loc[1] * loc[1];
             }
             else if (idir == 2) { // sum(mass * z^2)
-                ds = fab(i,j,k) * loc[2] * loc[2];
+                ds = q * loc[2] * loc[2];
             }
             else { // sum(mass * r^2)
-                ds = fab(i,j,k) * (loc[0] * loc[0] + loc[1] * loc[1] + loc[2] * loc[2]);
+                ds = q * (loc[0] * loc[0] + loc[1] * loc[1] + loc[2] * loc[2]);
             }
 
             return {ds};
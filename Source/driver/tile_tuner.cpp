@@ -0,0 +1,145 @@
+#include <tile_tuner.H>
+
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Print.H>
+
+#include <algorithm>
+#include <limits>
+
+using namespace amrex;
+
+namespace {
+
+    // the tile shapes we try.  The tiles are always long in x, since
+    // that is the direction of the innermost loops.
+
+#if AMREX_SPACEDIM == 1
+    const Vector<IntVect> tile_candidates = {IntVect(64), IntVect(256), IntVect(1024)};
+#elif AMREX_SPACEDIM == 2
+    const Vector<IntVect> tile_candidates = {IntVect(1024,4), IntVect(1024,8), IntVect(1024,16),
+                                             IntVect(1024,32), IntVect(1024,64), IntVect(64,64)};
+#else
+    const Vector<IntVect> tile_candidates = {IntVect(1024,4,4), IntVect(1024,8,8), IntVect(1024,16,16),
+                                             IntVect(1024,32,32), IntVect(1024,8,32), IntVect(64,16,16),
+                                             IntVect(32,32,32)};
+#endif
+
+}
+
+
+void
+TileTuner::define (const IntVect& default_size, const bool tune, const int end_step)
+{
+    m_size = default_size;
+    m_end_step = end_step;
+    m_defined = true;
+
+#ifdef AMREX_USE_GPU
+    // there is no tiling of the loops on GPUs
+
+    m_tuning = false;
+    amrex::ignore_unused(tune);
+#else
+    m_tuning = tune;
+#endif
+
+    m_candidates.clear();
+
+    if (m_tuning) {
+
+        // the default tile size is always a candidate
+
+        m_candidates.push_back(default_size);
+
+        for (const auto& ts : tile_candidates) {
+            if (std::find(m_candidates.begin(), m_candidates.end(), ts) == m_candidates.end()) {
+                m_candidates.push_back(ts);
+            }
+        }
+
+        m_time.assign(m_candidates.size(), 0.0_rt);
+        m_count.assign(m_candidates.size(), 0);
+
+        m_current = 0;
+        m_warm = false;
+
+    }
+}
+
+
+void
+TileTuner::pin (const IntVect& ts)
+{
+    m_size = ts;
+    m_defined = true;
+    m_tuning = false;
+}
+
+
+void
+TileTuner::record (const Real time_per_zone)
+{
+    if (!m_tuning) {
+        return;
+    }
+
+    if (!m_warm) {
+        m_warm = true;
+        return;
+    }
+
+    m_time[m_current] += time_per_zone;
+    m_count[m_current] += 1;
+
+    m_current = (m_current + 1) % static_cast<int>(m_candidates.size());
+}
+
+
+void
+TileTuner::finalize (const std::string& name, const int level, const bool report)
+{
+    if (!m_tuning) {
+        return;
+    }
+
+    m_tuning = false;
+
+    // each rank has timed the same sequence of candidates, so we use the
+    // slowest rank for each one
+
+    const int ncand = static_cast<int>(m_candidates.size());
+
+    ParallelDescriptor::ReduceRealMax(m_time.dataPtr(), ncand);
+
+    int best = -1;
+    Real best_time = std::numeric_limits<Real>::max();
+
+    for (int n = 0; n < ncand; ++n) {
+        if (m_count[n] > 0) {
+            const Real avg = m_time[n] / m_count[n];
+            if (avg < best_time) {
+                best_time = avg;
+                best = n;
+            }
+        }
+    }
+
+    if (best >= 0) {
+        m_size = m_candidates[best];
+    }
+
+    if (report) {
+        amrex::Print() << "... tile size autotuning for " << name << " on level " << level << std::endl;
+        for (int n = 0; n < ncand; ++n) {
+            amrex::Print() << "      " << m_candidates[n] << " : ";
+            if (m_count[n] > 0) {
+                amrex::Print() << m_time[n] / m_count[n] << " s / zone (" << m_count[n] << " samples)";
+            } else {
+                amrex::Print() << "not timed";
+            }
+            amrex::Print() << std::endl;
+        }
+        amrex::Print() << "    using tile size " << m_size << " for " << name
+                       << " on level " << level << std::endl;
+    }
+}
@@ -1,9 +1,6 @@
 #include <Castro.H>
 #include <Castro_F.H>
-
-#ifdef DIFFUSION
-#include <conductivity.H>
-#endif
+#include <timestep.H>
 
 #ifdef MHD
 #include <mhd_util.H>
@@ -13,14 +10,6 @@
 #include <Rotation.H>
 #endif
 
-#ifdef REACTIONS
-#ifdef NETWORK_HAS_CXX_IMPLEMENTATION
-#include <actual_rhs.H>
-#else
-#include <fortran_to_cxx_actual_rhs.H>
-#endif
-#endif
-
 #ifdef RADIATION
 #include <Radiation.H>
 #endif
@@ -45,6 +34,8 @@ Castro::estdt_cfl(const Real time)
 
   const MultiFab& stateMF = get_new_data(State_Type);
 
+  const bool lmol = !(castro::time_integration_method == 0 || castro::time_integration_method == 3);
+
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
@@ -97,40 +88,10 @@ Castro::estdt_cfl(const Real time)
 
       Real c = eos_state.cs;
 
-      Real dt1 = dx[0]/(c + std::abs(ux));
-
-      Real dt2;
-#if AMREX_SPACEDIM >= 2
-      dt2 = dx[1]/(c + std::abs(uy));
-#else
-      dt2 = dt1;
-#endif
-
-      Real dt3;
-#if AMREX_SPACEDIM == 3
-      dt3 = dx[2]/(c + std::abs(uz));
-#else
-      dt3 = dt1;
-#endif
-
       // The CTU method has a less restrictive timestep than MOL-based
       // schemes (including the true SDC).  Since the simplified SDC
       // solver is based on CTU, we can use its timestep.
-      if (castro::time_integration_method == 0 || castro::time_integration_method == 3) {
-        return {amrex::min(dt1, dt2, dt3)};
-
-      } else {
-        // method of lines-style constraint is tougher
-        Real dt_tmp = 1.0_rt/dt1;
-#if AMREX_SPACEIM >= 2
-        dt_tmp += 1.0_rt/dt2;
-#endif
-#if AMREX_SPACEDIM == 3
-        dt_tmp += 1.0_rt/dt3;
-#endif
-
-        return 1.0_rt/dt_tmp;
-      }
+      return {estdt_signal_zone(ux, uy, uz, c, c, c, dx, lmol)};
 
     });
 
@@ -226,23 +187,7 @@ Castro::estdt_mhd()
         cz = 0.0_rt;
       }
 
-      Real dt1 = dx[0]/(cx + std::abs(ux));
-
-      Real dt2;
-#if AMREX_SPACEDIM >= 2
-      dt2 = dx[1]/(cy + std::abs(uy));
-#else
-      dt2 = dt1;
-#endif
-
-      Real dt3;
-#if AMREX_SPACEDIM == 3
-      dt3 = dx[2]/(cz + std::abs(uz));
-#else
-      dt3 = dt1;
-#endif
-
-      return {amrex::min(dt1, dt2, dt3)};
+      return {estdt_signal_zone(ux, uy, uz, cx, cy, cz, dx, false)};
 
     });
 
@@ -312,29 +257,7 @@ Castro::estdt_temp_diffusion(void)
 
                        eos(eos_input_re, eos_state);
 
-                       // we also need the conductivity
-                       conductivity(eos_state);
-
-                       // maybe we should check (and take action) on negative cv here?
-                       Real D = eos_state.conductivity * rho_inv / eos_state.cv;
-
-                       Real dt1 = 0.5_rt * dx[0]*dx[0] / D;
-
-                       Real dt2;
-#if AMREX_SPACEDIM >= 2
-                       dt2 = 0.5_rt * dx[1]*dx[1] / D;
-#else
-                       dt2 = dt1;
-#endif
-
-                       Real dt3;
-#if AMREX_SPACEDIM >= 3
-                       dt3 = 0.5_rt * dx[2]*dx[2] / D;
-#else
-                       dt3 = dt1;
-#endif
-
-                       return {amrex::min(dt1, dt2, dt3)};
+                       return {estdt_diffusion_zone(eos_state, dx)};
 
                      } else {
                        return lmax_dt/lcfl;
@@ -350,6 +273,22 @@ Castro::estdt_temp_diffusion(void)
 #endif
 
 #ifdef REACTIONS
+bool
+Castro::burn_rates_current()
+{
+    // The rates are only current if the burn was the last thing to
+    // change the new-time state on these grids.  A regrid gives us a
+    // new level without any rates, and a restart does not store them.
+
+    const MultiFab& S_new = get_new_data(State_Type);
+
+    return castro::estdt_burning_from_burn == 1 &&
+           burn_rates.ok() &&
+           burn_rates.boxArray() == S_new.boxArray() &&
+           burn_rates.DistributionMap() == S_new.DistributionMap() &&
+           burn_rates_time == state[State_Type].curTime();
+}
+
 Real
 Castro::estdt_burning()
 {
@@ -362,6 +301,11 @@ Castro::estdt_burning()
 
     MultiFab& S_new = get_new_data(State_Type);
 
+    // Zones that were burned in the last burn already have their
+    // rates, and only the rest need the network RHS.
+
+    const bool use_rates = burn_rates_current();
+
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
@@ -370,13 +314,7 @@ Castro::estdt_burning()
         const Box& box = mfi.validbox();
 
         const auto S = S_new[mfi].array();
-
-        const auto dx = geom.CellSizeArray();
-
-        // Set a floor on the minimum size of a derivative. This floor
-        // is small enough such that it will result in no timestep limiting.
-
-        const Real derivative_floor = 1.e-50_rt;
+        const auto rates = use_rates ? burn_rates.const_array(mfi) : Array4<Real const>{};
 
         // We want to limit the timestep so that it is not larger than
         // dtnuc_e * (e / (de/dt)).  If the timestep factor dtnuc is
@@ -400,10 +338,17 @@ Castro::estdt_burning()
         // call before we do the RHS call so that we have accurate
         // values for the thermodynamic data like abar, zbar, etc.
         // But we will call in (rho, T) mode, which is inexpensive.
+        //
+        // With castro.estdt_burning_from_burn, we instead use the rates
+        // from the last burn where we have them.
 
         reduce_op.eval(box, reduce_data,
         [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> ReduceTuple
         {
+            if (use_rates && rates(i,j,k,0) > 0.0_rt) {
+                return {estdt_burning_rates_zone(i, j, k, S, rates)};
+            }
+
             Real rhoInv = 1.0_rt / S(i,j,k,URHO);
 
             burn_t state;
@@ -425,64 +370,11 @@ Castro::estdt_burning()
                 return {1.e200_rt};
             }
 
-            Real e    = state.e;
-            Real T    = amrex::max(state.T, castro::small_temp);
-            Real X[NumSpec];
-            for (int n = 0; n < NumSpec; ++n) {
-                X[n] = amrex::max(state.xn[n], small_x);
-            }
+            Real e = state.e;
 
             eos(eos_input_rt, state);
 
-#ifdef STRANG
-            state.self_heat = true;
-#endif
-            Array1D<Real, 1, neqs> ydot;
-            actual_rhs(state, ydot);
-
-            Real dedt = ydot(net_ienuc);
-            Real dXdt[NumSpec];
-            for (int n = 0; n < NumSpec; ++n) {
-                dXdt[n] = ydot(n+1) * aion[n];
-            }
-
-            // Apply a floor to the derivatives. This ensures that we don't
-            // divide by zero; it also gives us a quick method to disable
-            // the timestep limiting, because the floor is small enough
-            // that the implied timestep will be very large, and thus
-            // ignored compared to other limiters.
-
-            dedt = amrex::max(std::abs(dedt), derivative_floor);
-
-            for (int n = 0; n < NumSpec; ++n) {
-                if (X[n] >= castro::dtnuc_X_threshold) {
-                    dXdt[n] = amrex::max(std::abs(dXdt[n]), derivative_floor);
-                } else {
-                    dXdt[n] = derivative_floor;
-                }
-            }
-
-            Real dt_tmp = 1.e200_rt;
-
-#ifdef NSE
-            // we need to use the eos_state interface here because for
-            // SDC, if we come in with a burn_t, it expects to
-            // evaluate the NSE criterion based on the conserved state.
-
-            eos_t eos_state;
-            burn_to_eos(state, eos_state);
-
-            if (!in_nse(eos_state)) {
-#endif
-                dt_tmp = dtnuc_e * e / dedt;
-#ifdef NSE
-            }
-#endif
-            for (int n = 0; n < NumSpec; ++n) {
-                dt_tmp = amrex::min(dt_tmp, dtnuc_X * (X[n] / dXdt[n]));
-            }
-
-            return {dt_tmp};
+            return {estdt_burning_zone(state, e)};
         });
 
     }
@@ -555,21 +447,7 @@ Castro::estdt_rad ()
             Real uy = u(i,j,k,UMY) * rhoInv;
             Real uz = u(i,j,k,UMZ) * rhoInv;
 
-            Real dt1 = dx[0] / (c + std::abs(ux));
-#if AMREX_SPACEDIM >= 2
-            Real dt2 = dx[1] / (c + std::abs(uy));
-#else
-            Real dt2 = std::numeric_limits<Real>::max();
-#endif
-#if AMREX_SPACEDIM == 3
-            Real dt3 = dx[2] / (c + std::abs(uz));
-#else
-            Real dt3 = std::numeric_limits<Real>::max();
-#endif
-
-            Real dt_min = amrex::min(dt1, dt2, dt3);
-
-            return {dt_min};
+            return {estdt_signal_zone(ux, uy, uz, c, c, c, dx, false)};
         });
 
         Gpu::synchronize();
@@ -582,3 +460,250 @@ Castro::estdt_rad ()
     return estdt;
 }
 #endif
+
+void
+Castro::estdt_fused(const Real time, const bool include_hydro,
+                    Real& dt_hydro, Real& dt_diffusion, Real& dt_burning)
+{
+
+  // Evaluate all of the active timestep limiters in a single sweep
+  // over the level.  Each zone is loaded once and gets at most one EOS
+  // call.  In (rho, e) mode it gives the sound speed for the hydro
+  // limiter, c_v for the diffusion limiter, and the thermodynamics
+  // for the network RHS of the burning limiter.  Zones that only need
+  // the burning limiter call the EOS in (rho, T) mode with the stored
+  // temperature, as estdt_burning does.  The result is a separate
+  // minimum for each limiter, so the caller can tell which one was
+  // binding.  The values are local to this rank.
+
+  BL_PROFILE("Castro::estdt_fused()");
+
+  const auto dx = geom.CellSizeArray();
+
+#ifdef ROTATION
+  GeometryData geomdata = geom.data();
+#endif
+
+  const bool lhydro = do_hydro == 1 && include_hydro;
+  const bool lmol = !(castro::time_integration_method == 0 || castro::time_integration_method == 3);
+
+#ifdef RADIATION
+  const bool lrad = lhydro && Radiation::rad_hydro_combined;
+  const MultiFab& radMF = get_new_data(Rad_Type);
+#endif
+
+#ifdef DIFFUSION
+  const bool ldiffusion = diffuse_temp == 1;
+  const Real ldiffuse_cutoff_density = diffuse_cutoff_density;
+#endif
+  const Real lmax_dt = max_dt;
+  const Real lcfl = cfl;
+
+#ifdef REACTIONS
+  const bool lburning = do_react == 1 && !(castro::dtnuc_e > 1.e199_rt && castro::dtnuc_X > 1.e199_rt);
+  const bool use_rates = lburning && burn_rates_current();
+#endif
+
+  ReduceOps<ReduceOpMin, ReduceOpMin, ReduceOpMin> reduce_op;
+  ReduceData<Real, Real, Real> reduce_data(reduce_op);
+  using ReduceTuple = typename decltype(reduce_data)::Type;
+
+  const MultiFab& stateMF = get_new_data(State_Type);
+
+#ifdef MHD
+  const MultiFab& bxMF = get_new_data(Mag_Type_x);
+  const MultiFab& byMF = get_new_data(Mag_Type_y);
+  const MultiFab& bzMF = get_new_data(Mag_Type_z);
+#endif
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+
+#ifdef RADIATION
+    FArrayBox gPr;
+#endif
+
+    for (MFIter mfi(stateMF, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+      const Box& box = mfi.tilebox();
+
+      auto u = stateMF.array(mfi);
+
+#ifdef REACTIONS
+      const auto rates = use_rates ? burn_rates.const_array(mfi) : Array4<Real const>{};
+#endif
+
+#ifdef MHD
+      auto bx_arr = bxMF.array(mfi);
+      auto by_arr = byMF.array(mfi);
+      auto bz_arr = bzMF.array(mfi);
+#endif
+
+#ifdef RADIATION
+      gPr.resize(box);
+      Elixir elix_gPr = gPr.elixir();
+      if (lrad) {
+        radiation->estimate_gamrPr(stateMF[mfi], radMF[mfi], gPr, dx.data(), mfi.validbox());
+      }
+      auto gPr_arr = gPr.array();
+#endif
+
+      reduce_op.eval(box, reduce_data,
+      [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> ReduceTuple
+      {
+
+        Real dt_h = 1.e200_rt;
+        Real dt_d = lmax_dt / lcfl;
+        Real dt_b = 1.e200_rt;
+
+        Real rhoInv = 1.0_rt / u(i,j,k,URHO);
+
+        eos_t eos_state;
+        eos_state.rho = u(i,j,k,URHO);
+        eos_state.T = u(i,j,k,UTEMP);
+        eos_state.e = u(i,j,k,UEINT) * rhoInv;
+        for (int n = 0; n < NumSpec; n++) {
+          eos_state.xn[n] = u(i,j,k,UFS+n) * rhoInv;
+        }
+#if NAUX_NET > 0
+        for (int n = 0; n < NumAux; n++) {
+          eos_state.aux[n] = u(i,j,k,UFX+n) * rhoInv;
+        }
+#endif
+
+        // find out which limiters this zone participates in, so we
+        // can skip the EOS entirely if there are none
+
+        bool zone_diffusion = false;
+#ifdef DIFFUSION
+        zone_diffusion = ldiffusion && eos_state.rho > ldiffuse_cutoff_density;
+#endif
+
+        bool zone_burning = false;
+#ifdef REACTIONS
+        zone_burning = lburning &&
+                       !(eos_state.T < castro::react_T_min || eos_state.T > castro::react_T_max ||
+                         eos_state.rho < castro::react_rho_min || eos_state.rho > castro::react_rho_max);
+
+        // the rates from the last burn don't need the EOS
+
+        if (zone_burning && use_rates && rates(i,j,k,0) > 0.0_rt) {
+          dt_b = estdt_burning_rates_zone(i, j, k, u, rates);
+          zone_burning = false;
+        }
+#endif
+
+        if (!lhydro && !zone_diffusion && !zone_burning) {
+          return {dt_h, dt_d, dt_b};
+        }
+
+        // one EOS call serves all of the limiters.  The burning limiter
+        // alone uses the stored temperature, as estdt_burning does;
+        // otherwise it takes the temperature from (rho, e), which is
+        // what the stored temperature was last reset to.
+
+        if (lhydro || zone_diffusion) {
+          eos(eos_input_re, eos_state);
+        } else {
+          eos(eos_input_rt, eos_state);
+        }
+
+#ifdef REACTIONS
+        if (zone_burning) {
+          burn_t burn_state;
+          eos_to_burn(eos_state, burn_state);
+
+          dt_b = estdt_burning_zone(burn_state, u(i,j,k,UEINT) * rhoInv);
+        }
+#endif
+
+        if (lhydro) {
+
+          Real ux = u(i,j,k,UMX) * rhoInv;
+          Real uy = u(i,j,k,UMY) * rhoInv;
+          Real uz = u(i,j,k,UMZ) * rhoInv;
+
+#if defined(MHD)
+          Real bcx = 0.5_rt * (bx_arr(i+1,j,k) + bx_arr(i,j,k));
+          Real bcy = 0.5_rt * (by_arr(i,j+1,k) + by_arr(i,j,k));
+          Real bcz = 0.5_rt * (bz_arr(i,j,k+1) + bz_arr(i,j,k));
+
+          Real as = eos_state.gam1 * eos_state.p * rhoInv;
+          Real ca = (bcx*bcx + bcy*bcy + bcz*bcz) * rhoInv;
+
+          Real cx = 0.0_rt;
+          Real cy = 0.0_rt;
+          Real cz = 0.0_rt;
+
+          if (u(i,j,k,UEINT) * rhoInv > 0_rt) {
+            eos_soundspeed_mhd(cx, as, ca, bcx*bcx * rhoInv);
+            eos_soundspeed_mhd(cy, as, ca, bcy*bcy * rhoInv);
+            eos_soundspeed_mhd(cz, as, ca, bcz*bcz * rhoInv);
+          }
+
+          dt_h = estdt_signal_zone(ux, uy, uz, cx, cy, cz, dx, false);
+#else
+
+          Real c = eos_state.cs;
+
+#ifdef RADIATION
+          if (lrad) {
+            c = std::sqrt(c * c + gPr_arr(i,j,k) * rhoInv);
+            dt_h = estdt_signal_zone(ux, uy, uz, c, c, c, dx, false);
+          } else
+#endif
+          {
+#ifdef ROTATION
+            if (castro::do_rotation == 1 && castro::state_in_rotating_frame != 1) {
+              GpuArray<Real, 3> vel;
+              vel[0] = ux;
+              vel[1] = uy;
+              vel[2] = uz;
+
+              inertial_to_rotational_velocity(i, j, k, geomdata, time, vel);
+
+              ux = vel[0];
+              uy = vel[1];
+              uz = vel[2];
+            }
+#endif
+            dt_h = estdt_signal_zone(ux, uy, uz, c, c, c, dx, lmol);
+          }
+#endif
+
+        }
+
+#ifdef DIFFUSION
+        if (zone_diffusion) {
+          dt_d = estdt_diffusion_zone(eos_state, dx);
+        }
+#endif
+
+        return {dt_h, dt_d, dt_b};
+
+      });
+
+    }
+
+  }
+
+  ReduceTuple hv = reduce_data.value();
+
+  dt_hydro = amrex::get<0>(hv);
+  dt_diffusion = amrex::get<1>(hv);
+  dt_burning = amrex::get<2>(hv);
+
+#ifdef RADIATION
+  // as in estdt_rad, the radiation-hydro limiter is capped by max_dt
+
+  if (lrad) {
+    dt_hydro = amrex::min(dt_hydro, lmax_dt / lcfl);
+  }
+#endif
+
+#ifndef ROTATION
+  amrex::ignore_unused(time);
+#endif
+
+}
@@ -2330,6 +2330,11 @@ Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const Vector<MultiF
       physbc_lo[dir] = phys_bc->hi(dir);
     }
 
+    // With gravity.direct_sum_bcs = 2, we approximate the sum over the
+    // zones of each box with a tree instead of adding up every zone.
+
+    const bool use_tree = gravity::direct_sum_bcs == 2;
+
     for (int lev = crse_level; lev <= fine_level; ++lev) {
 
         // Create a local copy of the RHS so that we can mask it.
@@ -2375,7 +2380,10 @@ Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const Vector<MultiF
             priv_bcYZLo[tid]->setVal<RunOn::Gpu>(0.0);
             priv_bcYZHi[tid]->setVal<RunOn::Gpu>(0.0);
 #endif
-            for (MFIter mfi(source, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            // The tree (gravity.direct_sum_bcs = 2) is built over a whole
+            // box, so we do not tile in that case.
+
+            for (MFIter mfi(source, use_tree ? false : TilingIfNotGPU()); mfi.isValid(); ++mfi)
             {
                 const Box bx = mfi.tilebox();
 
@@ -2416,6 +2424,202 @@ Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const Vector<MultiF
                 auto bcYZHi_arr = bcYZHi.array();
 #endif
 
+                if (use_tree) {
+
+                    // Build the tree for this box.  Level l holds the
+                    // moments of the zones in each 2**l x 2**l x 2**l
+                    // block, and we coarsen until we have a single node.
+                    // Each node is built from its (up to eight) children,
+                    // shifting their moments to the center of the node.
+
+                    Vector<FArrayBox> tree_fabs(direct_sum_tree::max_levels + 1);
+                    Vector<Gpu::Elixir> tree_elixirs(direct_sum_tree::max_levels + 1);
+
+                    direct_sum_tree_t tree;
+
+                    tree.rho = source.const_array(mfi);
+                    tree.vol = volume[lev]->const_array(mfi);
+
+                    int nlev = 0;
+                    Box top_bx = bx;
+
+                    while (top_bx.numPts() > 1 && nlev < direct_sum_tree::max_levels) {
+
+                        ++nlev;
+
+                        const Box lbx = amrex::coarsen(bx, 1 << nlev);
+
+                        tree_fabs[nlev].resize(lbx, direct_sum_tree::ncomp);
+                        tree_elixirs[nlev] = tree_fabs[nlev].elixir();
+
+                        auto node = tree_fabs[nlev].array();
+                        auto child = tree_fabs[nlev-1].const_array();
+
+                        const int l = nlev;
+                        const Real scale = static_cast<Real>(1 << l);
+                        const auto tree_rho = tree.rho;
+                        const auto tree_vol = tree.vol;
+
+                        amrex::ParallelFor(lbx,
+                        [=] AMREX_GPU_HOST_DEVICE (int I, int J, int K)
+                        {
+                            using namespace direct_sum_tree;
+
+                            Real cp[3];
+                            cp[0] = problo[0] + (static_cast<Real>(I) + 0.5_rt) * scale * dx[0];
+                            cp[1] = problo[1] + (static_cast<Real>(J) + 0.5_rt) * scale * dx[1];
+                            cp[2] = problo[2] + (static_cast<Real>(K) + 0.5_rt) * scale * dx[2];
+
+                            Real M = 0.0_rt;
+                            Real A = 0.0_rt;
+                            Real D[3] = {0.0_rt};
+                            Real Q[6] = {0.0_rt};
+
+                            for (int c = 0; c < 8; ++c) {
+
+                                const int ci = 2 * I + (c & 1);
+                                const int cj = 2 * J + ((c >> 1) & 1);
+                                const int ck = 2 * K + ((c >> 2) & 1);
+
+                                Real Mc, Ac;
+                                Real Dc[3] = {0.0_rt};
+                                Real Qc[6] = {0.0_rt};
+
+                                if (l == 1) {
+                                    if (!tree_rho.contains(ci, cj, ck)) {
+                                        continue;
+                                    }
+                                    Mc = tree_rho(ci,cj,ck) * tree_vol(ci,cj,ck);
+                                    Ac = std::abs(Mc);
+                                }
+                                else {
+                                    if (!child.contains(ci, cj, ck)) {
+                                        continue;
+                                    }
+                                    Mc = child(ci,cj,ck,mass);
+                                    Ac = child(ci,cj,ck,abs_mass);
+                                    for (int a = 0; a < 3; ++a) {
+                                        Dc[a] = child(ci,cj,ck,dipole+a);
+                                    }
+                                    for (int a = 0; a < 6; ++a) {
+                                        Qc[a] = child(ci,cj,ck,quadrupole+a);
+                                    }
+                                }
+
+                                // The offset of the child center from the node center.
+
+                                Real e[3];
+                                e[0] = problo[0] + (static_cast<Real>(ci) + 0.5_rt) * 0.5_rt * scale * dx[0] - cp[0];
+                                e[1] = problo[1] + (static_cast<Real>(cj) + 0.5_rt) * 0.5_rt * scale * dx[1] - cp[1];
+                                e[2] = problo[2] + (static_cast<Real>(ck) + 0.5_rt) * 0.5_rt * scale * dx[2] - cp[2];
+
+                                const Real e2 = e[0] * e[0] + e[1] * e[1] + e[2] * e[2];
+                                const Real De = Dc[0] * e[0] + Dc[1] * e[1] + Dc[2] * e[2];
+
+                                M += Mc;
+                                A += Ac;
+
+                                for (int a = 0; a < 3; ++a) {
+                                    D[a] += Dc[a] + Mc * e[a];
+                                }
+
+                                // Q_ab += Qc_ab + 3 (Dc_a e_b + Dc_b e_a) - 2 delta_ab (Dc . e)
+                                //                + Mc (3 e_a e_b - delta_ab e**2)
+
+                                int n = 0;
+                                for (int a = 0; a < 3; ++a) {
+                                    for (int b = a; b < 3; ++b) {
+                                        Q[n] += Qc[n] + 3.0_rt * (Dc[a] * e[b] + Dc[b] * e[a]) + 3.0_rt * Mc * e[a] * e[b];
+                                        if (a == b) {
+                                            Q[n] -= 2.0_rt * De + Mc * e2;
+                                        }
+                                        ++n;
+                                    }
+                                }
+
+                            }
+
+                            node(I,J,K,mass) = M;
+                            node(I,J,K,abs_mass) = A;
+                            for (int a = 0; a < 3; ++a) {
+                                node(I,J,K,dipole+a) = D[a];
+                            }
+                            for (int a = 0; a < 6; ++a) {
+                                node(I,J,K,quadrupole+a) = Q[a];
+                            }
+                        });
+
+                        top_bx = lbx;
+
+                    }
+
+                    tree.nlev = nlev;
+                    tree.top_i = top_bx.smallEnd(0);
+                    tree.top_j = top_bx.smallEnd(1);
+                    tree.top_k = top_bx.smallEnd(2);
+
+                    for (int l = 1; l <= nlev; ++l) {
+                        tree.node[l] = tree_fabs[l].const_array();
+                    }
+
+                    const Real theta = gravity::direct_sum_bcs_theta;
+
+                    // Now evaluate the potential at each boundary point.  As
+                    // above, the boundary conditions live directly on the
+                    // domain faces.
+
+                    amrex::ParallelFor(boxXY,
+                    [=] AMREX_GPU_HOST_DEVICE (int l, int m, int)
+                    {
+                        GpuArray<Real, 3> locb;
+                        locb[0] = direct_sum_bc_coord(l, bc_lo[0], bc_hi[0], problo[0], probhi[0], bc_dx[0]);
+                        locb[1] = direct_sum_bc_coord(m, bc_lo[1], bc_hi[1], problo[1], probhi[1], bc_dx[1]);
+
+                        locb[2] = problo[2];
+                        bcXYLo_arr(l,m,0) += direct_sum_tree_bc(locb, tree, problo, probhi, dx, theta,
+                                                                doSymmetricAddLo, doSymmetricAddHi);
+
+                        locb[2] = probhi[2];
+                        bcXYHi_arr(l,m,0) += direct_sum_tree_bc(locb, tree, problo, probhi, dx, theta,
+                                                                doSymmetricAddLo, doSymmetricAddHi);
+                    });
+
+                    amrex::ParallelFor(boxXZ,
+                    [=] AMREX_GPU_HOST_DEVICE (int l, int, int n)
+                    {
+                        GpuArray<Real, 3> locb;
+                        locb[0] = direct_sum_bc_coord(l, bc_lo[0], bc_hi[0], problo[0], probhi[0], bc_dx[0]);
+                        locb[2] = direct_sum_bc_coord(n, bc_lo[2], bc_hi[2], problo[2], probhi[2], bc_dx[2]);
+
+                        locb[1] = problo[1];
+                        bcXZLo_arr(l,0,n) += direct_sum_tree_bc(locb, tree, problo, probhi, dx, theta,
+                                                                doSymmetricAddLo, doSymmetricAddHi);
+
+                        locb[1] = probhi[1];
+                        bcXZHi_arr(l,0,n) += direct_sum_tree_bc(locb, tree, problo, probhi, dx, theta,
+                                                                doSymmetricAddLo, doSymmetricAddHi);
+                    });
+
+                    amrex::ParallelFor(boxYZ,
+                    [=] AMREX_GPU_HOST_DEVICE (int, int m, int n)
+                    {
+                        GpuArray<Real, 3> locb;
+                        locb[1] = direct_sum_bc_coord(m, bc_lo[1], bc_hi[1], problo[1], probhi[1], bc_dx[1]);
+                        locb[2] = direct_sum_bc_coord(n, bc_lo[2], bc_hi[2], problo[2], probhi[2], bc_dx[2]);
+
+                        locb[0] = problo[0];
+                        bcYZLo_arr(0,m,n) += direct_sum_tree_bc(locb, tree, problo, probhi, dx, theta,
+                                                                doSymmetricAddLo, doSymmetricAddHi);
+
+                        locb[0] = probhi[0];
+                        bcYZHi_arr(0,m,n) += direct_sum_tree_bc(locb, tree, problo, probhi, dx, theta,
+                                                                doSymmetricAddLo, doSymmetricAddHi);
+                    });
+
+                    continue;
+
+                }
+
                 amrex::ParallelFor(bx,
                 [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
                 {
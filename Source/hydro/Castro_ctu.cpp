@@ -92,15 +92,15 @@ Castro::ctu_ppm_states(const Box& bx, const Box& vbx,
                        Array4<Real const> const& flatn,
                        Array4<Real const> const& qaux_arr,
                        Array4<Real const> const& srcQ,
-                       Array4<Real> const& qxm,
-                       Array4<Real> const& qxp,
+                       Array4<qedge_t> const& qxm,
+                       Array4<qedge_t> const& qxp,
 #if AMREX_SPACEDIM >= 2
-                       Array4<Real> const& qym,
-                       Array4<Real> const& qyp,
+                       Array4<qedge_t> const& qym,
+                       Array4<qedge_t> const& qyp,
 #endif
 #if AMREX_SPACEDIM == 3
-                       Array4<Real> const& qzm,
-                       Array4<Real> const& qzp,
+                       Array4<qedge_t> const& qzm,
+                       Array4<qedge_t> const& qzp,
 #endif
 #if AMREX_SPACEDIM < 3
                        Array4<Real const> const& dloga,
@@ -157,15 +157,15 @@ Castro::ctu_ppm_rad_states(const Box& bx, const Box& vbx,
                            Array4<Real const> const& flatn,
                            Array4<Real const> const& qaux_arr,
                            Array4<Real const> const& srcQ,
-                           Array4<Real> const& qxm,
-                           Array4<Real> const& qxp,
+                           Array4<qedge_t> const& qxm,
+                           Array4<qedge_t> const& qxp,
 #if AMREX_SPACEDIM >= 2
-                           Array4<Real> const& qym,
-                           Array4<Real> const& qyp,
+                           Array4<qedge_t> const& qym,
+                           Array4<qedge_t> const& qyp,
 #endif
 #if AMREX_SPACEDIM == 3
-                           Array4<Real> const& qzm,
-                           Array4<Real> const& qzp,
+                           Array4<qedge_t> const& qzm,
+                           Array4<qedge_t> const& qzp,
 #endif
 #if AMREX_SPACEDIM < 3
                            Array4<Real const> const& dloga,
@@ -219,15 +219,15 @@ Castro::ctu_plm_states(const Box& bx, const Box& vbx,
                        Array4<Real const> const& flatn_arr,
                        Array4<Real const> const& qaux_arr,
                        Array4<Real const> const& srcQ,
-                       Array4<Real> const& qxm,
-                       Array4<Real> const& qxp,
+                       Array4<qedge_t> const& qxm,
+                       Array4<qedge_t> const& qxp,
 #if AMREX_SPACEDIM >= 2
-                       Array4<Real> const& qym,
-                       Array4<Real> const& qyp,
+                       Array4<qedge_t> const& qym,
+                       Array4<qedge_t> const& qyp,
 #endif
 #if AMREX_SPACEDIM == 3
-                       Array4<Real> const& qzm,
-                       Array4<Real> const& qzp,
+                       Array4<qedge_t> const& qzm,
+                       Array4<qedge_t> const& qzp,
 #endif
 #if AMREX_SPACEDIM < 3
                        Array4<Real const> const& dloga,
@@ -436,8 +436,8 @@ Castro::ctu_plm_states(const Box& bx, const Box& vbx,
 
 void
 Castro::add_species_source_to_states(const Box& bx, const int idir, const Real dt,
-                                     Array4<Real> const& qleft,
-                                     Array4<Real> const& qright,
+                                     Array4<qedge_t> const& qleft,
+                                     Array4<qedge_t> const& qright,
                                      Array4<Real const> const& src_q)
 {
 
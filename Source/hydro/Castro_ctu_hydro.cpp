@@ -2,6 +2,8 @@
 #include <Castro_util.H>
 #include <Castro_F.H>
 #include <Castro_hydro.H>
+#include <scratch_arena.H>
+#include <timestep.H>
 
 #ifdef RADIATION
 #include <Radiation.H>
@@ -23,6 +25,8 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
 
   const Real strt_time = ParallelDescriptor::second();
 
+  const IntVect tile_size = get_hydro_tile_size();
+
   // this constructs the hydrodynamic source (essentially the flux
   // divergence) using the CTU framework for unsplit hydrodynamics
 
@@ -33,7 +37,7 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
   GeometryData geomdata = geom.data();
 #endif
 
-#if AMREX_SPACEDIM == 2
+#if AMREX_SPACEDIM <= 2
   int coord = geom.Coord();
 #endif
 
@@ -63,11 +67,44 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
   }
 #endif
 
+  // count the tiles we were able to skip
+
+  Long num_uniform_tiles = 0;
+  Long num_tiles = 0;
+
+  // optionally find the CFL-limited timestep from the sound speed and
+  // velocity that ctoprim gives us, so estTimeStep does not need to
+  // make its own EOS sweep.  The rotating-frame and radiation signal
+  // speeds are not what we have here, so we don't harvest in those
+  // cases.
+
+  bool harvest_estdt = hydro_harvest_estdt == 1;
+#ifdef ROTATION
+  if (castro::do_rotation == 1 && castro::state_in_rotating_frame != 1) {
+      harvest_estdt = false;
+  }
+#endif
+#ifdef RADIATION
+  harvest_estdt = false;
+#endif
+
+  const auto estdt_dx = geom.CellSizeArray();
+
+  ReduceOps<ReduceOpMin> estdt_reduce_op;
+  ReduceData<Real> estdt_reduce_data(estdt_reduce_op);
+  using EstdtReduceTuple = typename decltype(estdt_reduce_data)::Type;
+
+  // make sure that every thread has its own scratch arena
+
+  while (static_cast<int>(hydro_scratch.size()) < OpenMP::get_max_threads()) {
+      hydro_scratch.push_back(std::make_unique<ScratchArena>());
+  }
+
 #ifdef _OPENMP
 #ifdef RADIATION
-#pragma omp parallel reduction(max:nstep_fsp)
+#pragma omp parallel reduction(max:nstep_fsp) reduction(+:num_uniform_tiles,num_tiles)
 #else
-#pragma omp parallel
+#pragma omp parallel reduction(+:num_uniform_tiles,num_tiles)
 #endif
 #endif
   {
@@ -77,9 +114,14 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
 #endif
 
     // Declare local storage now. This should be done outside the MFIter loop,
-    // and then we will resize the Fabs in each MFIter loop iteration. Then,
-    // we apply an Elixir to ensure that their memory is saved until it is no
-    // longer needed (only relevant for the asynchronous case, usually on GPUs).
+    // and then in each MFIter loop iteration we carve the Fabs out of this
+    // thread's scratch arena. The arena persists across calls and is sized
+    // by the largest tile it has ever seen, so once that tile has been seen
+    // there is no further heap traffic. On GPUs the arena instead holds an
+    // Elixir for each Fab to ensure that its memory is saved until it is no
+    // longer needed.
+
+    ScratchArena& scratch = *hydro_scratch[OpenMP::get_thread_num()];
 
     FArrayBox flatn;
 #ifdef RADIATION
@@ -88,12 +130,12 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
     FArrayBox shk;
     FArrayBox q, qaux;
     FArrayBox src_q;
-    FArrayBox qxm, qxp;
+    BaseFab<qedge_t> qxm, qxp;
 #if AMREX_SPACEDIM >= 2
-    FArrayBox qym, qyp;
+    BaseFab<qedge_t> qym, qyp;
 #endif
 #if AMREX_SPACEDIM == 3
-    FArrayBox qzm, qzp;
+    BaseFab<qedge_t> qzm, qzp;
 #endif
     FArrayBox div;
 #if AMREX_SPACEDIM >= 2
@@ -102,7 +144,7 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
     FArrayBox rftmp1, rftmp2;
 #endif
     FArrayBox qgdnvtmp1, qgdnvtmp2;
-    FArrayBox ql, qr;
+    BaseFab<qedge_t> ql, qr;
 #endif
     FArrayBox flux[AMREX_SPACEDIM], qe[AMREX_SPACEDIM];
 #ifdef RADIATION
@@ -112,12 +154,12 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
     FArrayBox pradial;
 #endif
 #if AMREX_SPACEDIM == 3
-    FArrayBox qmyx, qpyx;
-    FArrayBox qmzx, qpzx;
-    FArrayBox qmxy, qpxy;
-    FArrayBox qmzy, qpzy;
-    FArrayBox qmxz, qpxz;
-    FArrayBox qmyz, qpyz;
+    BaseFab<qedge_t> qmyx, qpyx;
+    BaseFab<qedge_t> qmzx, qpzx;
+    BaseFab<qedge_t> qmxy, qpxy;
+    BaseFab<qedge_t> qmzy, qpzy;
+    BaseFab<qedge_t> qmxz, qpxz;
+    BaseFab<qedge_t> qmyz, qpyz;
 #endif
 
 #ifdef AMREX_USE_GPU
@@ -127,22 +169,26 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
 
     MultiFab& old_source = get_old_data(Source_Type);
 
-    for (MFIter mfi(S_new, hydro_tile_size); mfi.isValid(); ++mfi) {
+    for (MFIter mfi(S_new, tile_size); mfi.isValid(); ++mfi) {
+
+      const Real box_start_time = box_timer_start();
 
       size_t fab_size = 0;
 
+      // the temporaries from the previous tile are no longer needed
+
+      scratch.reset();
+
       // the valid region box
       const Box& bx = mfi.tilebox();
 
       const Box& obx = amrex::grow(bx, 1);
 
-      flatn.resize(obx, 1);
-      Elixir elix_flatn = flatn.elixir();
+      flatn = scratch.alloc(obx, 1);
       fab_size += flatn.nBytes();
 
 #ifdef RADIATION
-      flatg.resize(obx, 1);
-      Elixir elix_flatg = flatg.elixir();
+      flatg = scratch.alloc(obx, 1);
       fab_size += flatg.nBytes();
 #endif
 
@@ -184,25 +230,91 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
       // the conserved variables.
 
       const Box& qbx = amrex::grow(bx, NUM_GROW);
-      const Box& qbx3 = amrex::grow(bx, 3);
 
-      q.resize(qbx, NQ);
-      Elixir elix_q = q.elixir();
+      q = scratch.alloc(qbx, NQ);
       fab_size += q.nBytes();
       Array4<Real> const q_arr = q.array();
 
-      qaux.resize(qbx, NQAUX);
-      Elixir elix_qaux = qaux.elixir();
+      qaux = scratch.alloc(qbx, NQAUX);
       fab_size += qaux.nBytes();
       Array4<Real> const qaux_arr = qaux.array();
 
-      ctoprim(qbx, time, Sborder.array(mfi),
+      // check whether this tile, including its ghost cells, holds a
+      // uniform state at rest with no sources.  In that case every
+      // interface state is just the zone state, and we can skip the
+      // reconstruction, transverse, and Riemann stages entirely.
+
+      bool uniform_tile = false;
+
+#if !defined(RADIATION) && !defined(HYBRID_MOMENTUM)
+      if (hydro_skip_uniform_tiles == 1) {
+          const Box& qbx3 = amrex::grow(bx, 3);
+
+          uniform_tile = uniform_state_at_rest(qbx, Sborder.array(mfi)) &&
+                         array_is_zero(qbx3, old_source.array(mfi)) &&
+                         array_is_zero(qbx3, source_corrector.array(mfi));
+
+#ifdef SIMPLIFIED_SDC
+#ifdef REACTIONS
+          if (uniform_tile && time_integration_method == SimplifiedSpectralDeferredCorrections && do_react) {
+              MultiFab& SDC_react_source = get_new_data(Simplified_SDC_React_Type);
+              uniform_tile = array_is_zero(qbx3, SDC_react_source.array(mfi));
+          }
+#endif
+#endif
+      }
+#endif
+
+      if (uniform_tile) {
+
+          // we only need the EOS in a single zone -- then copy that
+          // primitive state everywhere
+
+          const Box& onebx = amrex::Box(bx.smallEnd(), bx.smallEnd());
+
+          ctoprim(onebx, time, Sborder.array(mfi),
 #ifdef RADIATION
-              Erborder.array(mfi), lamborder.array(mfi),
+                  Erborder.array(mfi), lamborder.array(mfi),
 #endif
-              q_arr, qaux_arr);
+                  q_arr, qaux_arr);
 
+          const auto lo = amrex::lbound(bx);
 
+          amrex::ParallelFor(qbx, NQ,
+          [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k, int n)
+          {
+              q_arr(i,j,k,n) = q_arr(lo.x,lo.y,lo.z,n);
+          });
+
+          amrex::ParallelFor(qbx, NQAUX,
+          [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k, int n)
+          {
+              qaux_arr(i,j,k,n) = qaux_arr(lo.x,lo.y,lo.z,n);
+          });
+
+          num_uniform_tiles += 1;
+
+      } else {
+
+          ctoprim(qbx, time, Sborder.array(mfi),
+#ifdef RADIATION
+                  Erborder.array(mfi), lamborder.array(mfi),
+#endif
+                  q_arr, qaux_arr);
+
+      }
+
+      num_tiles += 1;
+
+      if (harvest_estdt) {
+          estdt_reduce_op.eval(bx, estdt_reduce_data,
+          [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> EstdtReduceTuple
+          {
+              Real c = qaux_arr(i,j,k,QC);
+              return {estdt_signal_zone(q_arr(i,j,k,QU), q_arr(i,j,k,QV), q_arr(i,j,k,QW),
+                                        c, c, c, estdt_dx, false)};
+          });
+      }
 
       Array4<Real const> const areax_arr = area[0].array(mfi);
 #if AMREX_SPACEDIM >= 2
@@ -214,1035 +326,1063 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
 
       Array4<Real> const vol_arr = volume.array(mfi);
 
+      Array4<Real const> const uin_arr = Sborder.array(mfi);
+
 #if AMREX_SPACEDIM < 3
       Array4<Real const> const dLogArea_arr = (dLogArea[0]).array(mfi);
 #endif
 
-      // compute the flattening coefficient
+      const Box& xbx = amrex::surroundingNodes(bx, 0);
+      const Box& gxbx = amrex::grow(xbx, 1);
+#if AMREX_SPACEDIM >= 2
+      const Box& ybx = amrex::surroundingNodes(bx, 1);
+      const Box& gybx = amrex::grow(ybx, 1);
+#endif
+#if AMREX_SPACEDIM == 3
+      const Box& zbx = amrex::surroundingNodes(bx, 2);
+      const Box& gzbx = amrex::grow(zbx, 1);
+#endif
+
+      shk = scratch.alloc(obx, 1);
+      fab_size += shk.nBytes();
+
+      Array4<Real> const shk_arr = shk.array();
+
+      div = scratch.alloc(obx, 1);
+      fab_size += div.nBytes();
+      auto div_arr = div.array();
+
+      flux[0] = scratch.alloc(gxbx, NUM_STATE);
+      fab_size += flux[0].nBytes();
+      Array4<Real> const flux0_arr = (flux[0]).array();
+
+      qe[0] = scratch.alloc(gxbx, NGDNV);
+      auto qex_arr = qe[0].array();
+      fab_size += qe[0].nBytes();
 
-      Array4<Real> const flatn_arr = flatn.array();
 #ifdef RADIATION
-      Array4<Real> const flatg_arr = flatg.array();
+      rad_flux[0] = scratch.alloc(gxbx, Radiation::nGroups);
+      fab_size += rad_flux[0].nBytes();
+      auto rad_flux0_arr = (rad_flux[0]).array();
 #endif
 
-      if (first_order_hydro == 1) {
-        amrex::ParallelFor(obx,
-        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
-        {
-          flatn_arr(i,j,k) = 0.0;
-        });
-      } else if (use_flattening == 1) {
+#if AMREX_SPACEDIM >= 2
+      flux[1] = scratch.alloc(gybx, NUM_STATE);
+      fab_size += flux[1].nBytes();
+      Array4<Real> const flux1_arr = (flux[1]).array();
+
+      qe[1] = scratch.alloc(gybx, NGDNV);
+      auto qey_arr = qe[1].array();
+      fab_size += qe[1].nBytes();
+
+#ifdef RADIATION
+      rad_flux[1] = scratch.alloc(gybx, Radiation::nGroups);
+      fab_size += rad_flux[1].nBytes();
+      auto const rad_flux1_arr = (rad_flux[1]).array();
+#endif
+#endif
+
+#if AMREX_SPACEDIM == 3
+      flux[2] = scratch.alloc(gzbx, NUM_STATE);
+      fab_size += flux[2].nBytes();
+      Array4<Real> const flux2_arr = (flux[2]).array();
 
-        uflatten(obx, q_arr, flatn_arr, QPRES);
+      qe[2] = scratch.alloc(gzbx, NGDNV);
+      auto qez_arr = qe[2].array();
+      fab_size += qe[2].nBytes();
 
 #ifdef RADIATION
-        uflatten(obx, q_arr, flatg_arr, QPTOT);
+      rad_flux[2] = scratch.alloc(gzbx, Radiation::nGroups);
+      fab_size += rad_flux[2].nBytes();
+      auto const rad_flux2_arr = (rad_flux[2]).array();
+#endif
+#endif
 
-        Real flatten_pp_thresh = radiation::flatten_pp_threshold;
+#if AMREX_SPACEDIM <= 2
+      if (!Geom().IsCartesian()) {
+          pradial = scratch.alloc(xbx, 1);
+      }
+      fab_size += pradial.nBytes();
+#endif
 
-        amrex::ParallelFor(obx,
-        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
-        {
-          flatn_arr(i,j,k) = flatn_arr(i,j,k) * flatg_arr(i,j,k);
+      if (uniform_tile) {
 
-          if (flatten_pp_thresh > 0.0) {
-            if ( q_arr(i-1,j,k,QU) + q_arr(i,j-1,k,QV) + q_arr(i,j,k-1,QW) >
-                 q_arr(i+1,j,k,QU) + q_arr(i,j+1,k,QV) + q_arr(i,j,k+1,QW) ) {
+          // the flow is at rest and uniform, so the solution of every
+          // Riemann problem is the zone state itself.  The only nonzero
+          // flux is the pressure in the normal momentum flux, and the
+          // Godunov state has zero velocity.  The Godunov state is filled
+          // in full, with the remaining components taken from the zone
+          // state as the Riemann solver would, since the scratch memory
+          // still holds the previous tile's values.
 
-              if (q_arr(i,j,k,QPRES) < flatten_pp_thresh * q_arr(i,j,k,QPTOT)) {
-                flatn_arr(i,j,k) = 0.0;
-              }
-            }
-          }
-        });
+          const auto lo = amrex::lbound(bx);
+
+          amrex::ParallelFor(obx,
+          [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+          {
+              shk_arr(i,j,k) = 0.0;
+              div_arr(i,j,k) = 0.0;
+          });
+
+          for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
+
+              const Box& nbx = amrex::surroundingNodes(bx, idir);
+
+              Array4<Real> const flux_arr = (flux[idir]).array();
+              Array4<Real> const qe_arr = (qe[idir]).array();
+#ifdef RADIATION
+              Array4<Real> const rad_flux_arr = (rad_flux[idir]).array();
 #endif
 
+              const bool mom_check = mom_flux_has_p(idir, idir, geom.Coord());
+
+              amrex::ParallelFor(nbx,
+              [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+              {
+                  Real p = amrex::max(q_arr(lo.x,lo.y,lo.z,QPRES), small_pres);
+
+                  for (int n = 0; n < NUM_STATE; ++n) {
+                      flux_arr(i,j,k,n) = 0.0;
+                  }
+
+                  if (mom_check) {
+                      flux_arr(i,j,k,UMX+idir) = p;
+                  }
+
+                  qe_arr(i,j,k,GDU) = 0.0;
+                  qe_arr(i,j,k,GDV) = 0.0;
+                  qe_arr(i,j,k,GDW) = 0.0;
+                  qe_arr(i,j,k,GDPRES) = p;
+#ifdef HYBRID_MOMENTUM
+                  qe_arr(i,j,k,GDRHO) = q_arr(lo.x,lo.y,lo.z,QRHO);
+#endif
+#ifdef RADIATION
+                  for (int g = 0; g < NGROUPS; ++g) {
+                      qe_arr(i,j,k,GDLAMS+g) = qaux_arr(lo.x,lo.y,lo.z,QLAMS+g);
+                      qe_arr(i,j,k,GDERADS+g) = q_arr(lo.x,lo.y,lo.z,QRAD+g);
+                      rad_flux_arr(i,j,k,g) = 0.0;
+                  }
+#endif
+              });
+
+              clean_hydro_fluxes(nbx, idir, div_arr, uin_arr, q_arr, vol_arr,
+                                 flux_arr, area[idir].array(mfi), dt);
+          }
+
       } else {
-        amrex::ParallelFor(obx,
-        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
-        {
-          flatn_arr(i,j,k) = 1.0;
-        });
-      }
 
-      const Box& xbx = amrex::surroundingNodes(bx, 0);
-      const Box& gxbx = amrex::grow(xbx, 1);
+        // Sweep through the tile in slabs.  In 3-d, with hydro_slab_size > 0,
+        // each slab is a few planes thick in z, and all of the interface
+        // states and transverse intermediates are only allocated over the
+        // slab (plus the ghost zones its stencil needs), so the working set
+        // stays in cache even for large tiles.  The primitive state, the
+        // fluxes, and the Godunov states are still defined over the whole
+        // tile, and each slab fills in its part of them.  Otherwise there is
+        // a single slab covering the tile.
+
+#if AMREX_SPACEDIM == 3
+        const int nslab = hydro_slab_size > 0 ? hydro_slab_size : bx.length(2);
+#else
+        const int nslab = bx.length(AMREX_SPACEDIM-1);
+#endif
+
+        for (int kslab = bx.smallEnd(AMREX_SPACEDIM-1); kslab <= bx.bigEnd(AMREX_SPACEDIM-1); kslab += nslab) {
+
+          // everything allocated from here on only lives for this slab
+
+          const auto slab_mark = scratch.mark();
+
+          Box sbx(bx);
+          sbx.setSmall(AMREX_SPACEDIM-1, kslab);
+          sbx.setBig(AMREX_SPACEDIM-1, std::min(kslab + nslab - 1, bx.bigEnd(AMREX_SPACEDIM-1)));
+
+          const Box& sobx = amrex::grow(sbx, 1);
+          const Box& sqbx3 = amrex::grow(sbx, 3);
+
+          const Box& sxbx = amrex::surroundingNodes(sbx, 0);
 #if AMREX_SPACEDIM >= 2
-      const Box& ybx = amrex::surroundingNodes(bx, 1);
-      const Box& gybx = amrex::grow(ybx, 1);
+          const Box& sybx = amrex::surroundingNodes(sbx, 1);
 #endif
 #if AMREX_SPACEDIM == 3
-      const Box& zbx = amrex::surroundingNodes(bx, 2);
-      const Box& gzbx = amrex::grow(zbx, 1);
+          const Box& szbx = amrex::surroundingNodes(sbx, 2);
 #endif
 
-      shk.resize(obx, 1);
-      Elixir elix_shk = shk.elixir();
-      fab_size += shk.nBytes();
+          // compute the flattening coefficient
 
-      Array4<Real> const shk_arr = shk.array();
+          Array4<Real> const flatn_arr = flatn.array();
+#ifdef RADIATION
+          Array4<Real> const flatg_arr = flatg.array();
+#endif
 
-      // Multidimensional shock detection
-      // Used for the hybrid Riemann solver
+          if (first_order_hydro == 1) {
+            amrex::ParallelFor(sobx,
+            [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+            {
+              flatn_arr(i,j,k) = 0.0;
+            });
+          } else if (use_flattening == 1) {
+
+            uflatten(sobx, q_arr, flatn_arr, QPRES);
+
+#ifdef RADIATION
+            uflatten(sobx, q_arr, flatg_arr, QPTOT);
+
+            Real flatten_pp_thresh = radiation::flatten_pp_threshold;
+
+            amrex::ParallelFor(sobx,
+            [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+            {
+              flatn_arr(i,j,k) = flatn_arr(i,j,k) * flatg_arr(i,j,k);
+
+              if (flatten_pp_thresh > 0.0) {
+                if ( q_arr(i-1,j,k,QU) + q_arr(i,j-1,k,QV) + q_arr(i,j,k-1,QW) >
+                     q_arr(i+1,j,k,QU) + q_arr(i,j+1,k,QV) + q_arr(i,j,k+1,QW) ) {
+
+                  if (q_arr(i,j,k,QPRES) < flatten_pp_thresh * q_arr(i,j,k,QPTOT)) {
+                    flatn_arr(i,j,k) = 0.0;
+                  }
+                }
+              }
+            });
+#endif
+
+          } else {
+            amrex::ParallelFor(sobx,
+            [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+            {
+              flatn_arr(i,j,k) = 1.0;
+            });
+          }
+
+          // Multidimensional shock detection
+          // Used for the hybrid Riemann solver and riemann_cg_shocks_only
 
 #ifdef SHOCK_VAR
-      bool compute_shock = true;
+          bool compute_shock = true;
 #else
-      bool compute_shock = false;
+          bool compute_shock = false;
 #endif
 
-      if (hybrid_riemann == 1 || compute_shock) {
-        shock(obx, q_arr, shk_arr);
-      }
-      else {
-        amrex::ParallelFor(obx,
-        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
-        {
-          shk_arr(i,j,k) = 0.0;
-        });
-      }
+          if (hybrid_riemann == 1 || riemann_cg_shocks_only == 1 || compute_shock) {
+            shock(sobx, q_arr, shk_arr);
+          }
+          else {
+            amrex::ParallelFor(sobx,
+            [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+            {
+              shk_arr(i,j,k) = 0.0;
+            });
+          }
 
-      // get the primitive variable hydro sources
+          // get the primitive variable hydro sources
 
-      src_q.resize(qbx3, NQSRC);
-      Elixir elix_src_q = src_q.elixir();
-      fab_size += src_q.nBytes();
-      Array4<Real> const src_q_arr = src_q.array();
+          src_q = scratch.alloc(sqbx3, NQSRC);
+          fab_size += src_q.nBytes();
+          Array4<Real> const src_q_arr = src_q.array();
 
-      Array4<Real> const old_src_arr = old_source.array(mfi);
-      Array4<Real> const src_corr_arr = source_corrector.array(mfi);
+          Array4<Real> const old_src_arr = old_source.array(mfi);
+          Array4<Real> const src_corr_arr = source_corrector.array(mfi);
 
-      src_to_prim(qbx3, dt, q_arr, old_src_arr, src_corr_arr, src_q_arr);
+          src_to_prim(sqbx3, dt, q_arr, old_src_arr, src_corr_arr, src_q_arr);
 
 #ifndef RADIATION
 #ifdef SIMPLIFIED_SDC
 #ifdef REACTIONS
-        // Add in the reactions source term; only done in simplified SDC.
+            // Add in the reactions source term; only done in simplified SDC.
 
-        if (time_integration_method == SimplifiedSpectralDeferredCorrections) {
+            if (time_integration_method == SimplifiedSpectralDeferredCorrections) {
 
-            MultiFab& SDC_react_source = get_new_data(Simplified_SDC_React_Type);
+                MultiFab& SDC_react_source = get_new_data(Simplified_SDC_React_Type);
 
-            if (do_react)
-              src_q.plus<RunOn::Device>(SDC_react_source[mfi], qbx3, qbx3, 0, 0, NQSRC);
+                if (do_react)
+                  src_q.plus<RunOn::Device>(SDC_react_source[mfi], sqbx3, sqbx3, 0, 0, NQSRC);
 
-        }
+            }
 #endif
 #endif
 #endif
 
 
-      // work on the interface states
+          // work on the interface states
 
-      qxm.resize(obx, NQ);
-      Elixir elix_qxm = qxm.elixir();
-      fab_size += shk.nBytes();
+          qxm = scratch.alloc<qedge_t>(sobx, NQ);
+          fab_size += shk.nBytes();
 
-      qxp.resize(obx, NQ);
-      Elixir elix_qxp = qxp.elixir();
-      fab_size += qxp.nBytes();
+          qxp = scratch.alloc<qedge_t>(sobx, NQ);
+          fab_size += qxp.nBytes();
 
-      Array4<Real> const qxm_arr = qxm.array();
-      Array4<Real> const qxp_arr = qxp.array();
+          Array4<qedge_t> const qxm_arr = qxm.array();
+          Array4<qedge_t> const qxp_arr = qxp.array();
 
 #if AMREX_SPACEDIM >= 2
-      qym.resize(obx, NQ);
-      Elixir elix_qym = qym.elixir();
-      fab_size += qym.nBytes();
+          qym = scratch.alloc<qedge_t>(sobx, NQ);
+          fab_size += qym.nBytes();
 
-      qyp.resize(obx, NQ);
-      Elixir elix_qyp = qyp.elixir();
-      fab_size += qyp.nBytes();
+          qyp = scratch.alloc<qedge_t>(sobx, NQ);
+          fab_size += qyp.nBytes();
 
-      Array4<Real> const qym_arr = qym.array();
-      Array4<Real> const qyp_arr = qyp.array();
+          Array4<qedge_t> const qym_arr = qym.array();
+          Array4<qedge_t> const qyp_arr = qyp.array();
 
 #endif
 
 #if AMREX_SPACEDIM == 3
-      qzm.resize(obx, NQ);
-      Elixir elix_qzm = qzm.elixir();
-      fab_size += qzm.nBytes();
+          qzm = scratch.alloc<qedge_t>(sobx, NQ);
+          fab_size += qzm.nBytes();
 
-      qzp.resize(obx, NQ);
-      Elixir elix_qzp = qzp.elixir();
-      fab_size += qzp.nBytes();
+          qzp = scratch.alloc<qedge_t>(sobx, NQ);
+          fab_size += qzp.nBytes();
 
-      Array4<Real> const qzm_arr = qzm.array();
-      Array4<Real> const qzp_arr = qzp.array();
+          Array4<qedge_t> const qzm_arr = qzm.array();
+          Array4<qedge_t> const qzp_arr = qzp.array();
 
 #endif
 
-      if (ppm_type == 0) {
+          if (ppm_type == 0) {
 
-        ctu_plm_states(obx, bx,
-                       q_arr,
-                       flatn_arr,
-                       qaux_arr,
-                       src_q_arr,
-                       qxm_arr, qxp_arr,
+            ctu_plm_states(sobx, sbx,
+                           q_arr,
+                           flatn_arr,
+                           qaux_arr,
+                           src_q_arr,
+                           qxm_arr, qxp_arr,
 #if AMREX_SPACEDIM >= 2
-                       qym_arr, qyp_arr,
+                           qym_arr, qyp_arr,
 #endif
 #if AMREX_SPACEDIM == 3
-                       qzm_arr, qzp_arr,
+                           qzm_arr, qzp_arr,
 #endif
 #if (AMREX_SPACEDIM < 3)
-                       dLogArea_arr,
+                           dLogArea_arr,
 #endif
-                       dt);
+                           dt);
 
-      } else {
+          } else {
 
 #ifdef RADIATION
-        ctu_ppm_rad_states(obx, bx,
-                           q_arr, flatn_arr, qaux_arr, src_q_arr,
-                           qxm_arr, qxp_arr,
+            ctu_ppm_rad_states(sobx, sbx,
+                               q_arr, flatn_arr, qaux_arr, src_q_arr,
+                               qxm_arr, qxp_arr,
 #if AMREX_SPACEDIM >= 2
-                           qym_arr, qyp_arr,
+                               qym_arr, qyp_arr,
 #endif
 #if AMREX_SPACEDIM == 3
-                           qzm_arr, qzp_arr,
+                               qzm_arr, qzp_arr,
 #endif
 #if AMREX_SPACEDIM < 3
-                           dLogArea_arr,
+                               dLogArea_arr,
 #endif
-                           dt);
+                               dt);
 #else
 
-        ctu_ppm_states(obx, bx,
-                       q_arr, flatn_arr, qaux_arr, src_q_arr,
-                       qxm_arr, qxp_arr,
+            ctu_ppm_states(sobx, sbx,
+                           q_arr, flatn_arr, qaux_arr, src_q_arr,
+                           qxm_arr, qxp_arr,
 #if AMREX_SPACEDIM >= 2
-                       qym_arr, qyp_arr,
+                           qym_arr, qyp_arr,
 #endif
 #if AMREX_SPACEDIM == 3
-                       qzm_arr, qzp_arr,
+                           qzm_arr, qzp_arr,
 #endif
 #if AMREX_SPACEDIM < 3
-                       dLogArea_arr,
-#endif
-                       dt);
-#endif
-
-      }
-
-      div.resize(obx, 1);
-      Elixir elix_div = div.elixir();
-      fab_size += div.nBytes();
-      auto div_arr = div.array();
-
-      // compute divu -- we'll use this later when doing the artifical viscosity
-      divu(obx, q_arr, div_arr);
-
-      flux[0].resize(gxbx, NUM_STATE);
-      Elixir elix_flux_x = flux[0].elixir();
-      fab_size += flux[0].nBytes();
-      Array4<Real> const flux0_arr = (flux[0]).array();
-
-      qe[0].resize(gxbx, NGDNV);
-      Elixir elix_qe_x = qe[0].elixir();
-      auto qex_arr = qe[0].array();
-      fab_size += qe[0].nBytes();
-
-#ifdef RADIATION
-      rad_flux[0].resize(gxbx, Radiation::nGroups);
-      Elixir elix_rad_flux_x = rad_flux[0].elixir();
-      fab_size += rad_flux[0].nBytes();
-      auto rad_flux0_arr = (rad_flux[0]).array();
-#endif
-
-#if AMREX_SPACEDIM >= 2
-      flux[1].resize(gybx, NUM_STATE);
-      Elixir elix_flux_y = flux[1].elixir();
-      fab_size += flux[1].nBytes();
-      Array4<Real> const flux1_arr = (flux[1]).array();
-
-      qe[1].resize(gybx, NGDNV);
-      Elixir elix_qe_y = qe[1].elixir();
-      auto qey_arr = qe[1].array();
-      fab_size += qe[1].nBytes();
-
-#ifdef RADIATION
-      rad_flux[1].resize(gybx, Radiation::nGroups);
-      Elixir elix_rad_flux_y = rad_flux[1].elixir();
-      fab_size += rad_flux[1].nBytes();
-      auto const rad_flux1_arr = (rad_flux[1]).array();
+                           dLogArea_arr,
 #endif
+                           dt);
 #endif
 
-#if AMREX_SPACEDIM == 3
-      flux[2].resize(gzbx, NUM_STATE);
-      Elixir elix_flux_z = flux[2].elixir();
-      fab_size += flux[2].nBytes();
-      Array4<Real> const flux2_arr = (flux[2]).array();
+          }
 
-      qe[2].resize(gzbx, NGDNV);
-      Elixir elix_qe_z = qe[2].elixir();
-      auto qez_arr = qe[2].array();
-      fab_size += qe[2].nBytes();
-
-#ifdef RADIATION
-      rad_flux[2].resize(gzbx, Radiation::nGroups);
-      Elixir elix_rad_flux_z = rad_flux[2].elixir();
-      fab_size += rad_flux[2].nBytes();
-      auto const rad_flux2_arr = (rad_flux[2]).array();
-#endif
-#endif
-
-#if AMREX_SPACEDIM <= 2
-      if (!Geom().IsCartesian()) {
-          pradial.resize(xbx, 1);
-      }
-      Elixir elix_pradial = pradial.elixir();
-      fab_size += pradial.nBytes();
-#endif
+          // compute divu -- we'll use this later when doing the artifical viscosity
+          divu(sobx, q_arr, div_arr);
 
 #if AMREX_SPACEDIM == 1
 
 #ifdef PRIM_SPECIES_HAVE_SOURCES
-      // if we are doing species sources, add them here
+          // if we are doing species sources, add them here
 
-      add_species_source_to_states(xbx, 0, dt,
-                                   qxm_arr, qxp_arr, src_q_arr);
+          add_species_source_to_states(sxbx, 0, dt,
+                                       qxm_arr, qxp_arr, src_q_arr);
 #endif
 
-      // compute the fluxes through the x-interface
+          // compute the fluxes through the x-interface
 
-      cmpflx_plus_godunov(xbx,
-                          qxm_arr, qxp_arr,
-                          flux0_arr,
+          cmpflx_plus_godunov(sxbx,
+                              qxm_arr, qxp_arr,
+                              flux0_arr,
 #ifdef RADIATION
-                          rad_flux0_arr,
+                              rad_flux0_arr,
 #endif
-                          qex_arr,
-                          qaux_arr,
-                          shk_arr,
-                          0, false);
+                              qex_arr,
+                              qaux_arr,
+                              shk_arr,
+                              0, false);
+
+          // correct the final x fluxes (artificial viscosity, limiters,
+          // species normalization) while they are still in cache
+
+          clean_hydro_fluxes(sxbx, 0, div_arr, uin_arr, q_arr, vol_arr,
+                             flux0_arr, areax_arr, dt);
 
 #endif // 1-d
 
 
 
 #if AMREX_SPACEDIM >= 2
-      ftmp1.resize(obx, NUM_STATE);
-      Elixir elix_ftmp1 = ftmp1.elixir();
-      auto ftmp1_arr = ftmp1.array();
-      fab_size += ftmp1.nBytes();
+          ftmp1 = scratch.alloc(sobx, NUM_STATE);
+          auto ftmp1_arr = ftmp1.array();
+          fab_size += ftmp1.nBytes();
 
-      ftmp2.resize(obx, NUM_STATE);
-      Elixir elix_ftmp2 = ftmp2.elixir();
-      auto ftmp2_arr = ftmp2.array();
-      fab_size += ftmp2.nBytes();
+          ftmp2 = scratch.alloc(sobx, NUM_STATE);
+          auto ftmp2_arr = ftmp2.array();
+          fab_size += ftmp2.nBytes();
 
 #ifdef RADIATION
-      rftmp1.resize(obx, Radiation::nGroups);
-      Elixir elix_rftmp1 = rftmp1.elixir();
-      auto rftmp1_arr = rftmp1.array();
-      fab_size += rftmp1.nBytes();
+          rftmp1 = scratch.alloc(sobx, Radiation::nGroups);
+          auto rftmp1_arr = rftmp1.array();
+          fab_size += rftmp1.nBytes();
 
-      rftmp2.resize(obx, Radiation::nGroups);
-      Elixir elix_rftmp2 = rftmp2.elixir();
-      auto rftmp2_arr = rftmp2.array();
-      fab_size += rftmp2.nBytes();
+          rftmp2 = scratch.alloc(sobx, Radiation::nGroups);
+          auto rftmp2_arr = rftmp2.array();
+          fab_size += rftmp2.nBytes();
 #endif
 
-      qgdnvtmp1.resize(obx, NGDNV);
-      Elixir elix_qgdnvtmp1 = qgdnvtmp1.elixir();
-      auto qgdnvtmp1_arr = qgdnvtmp1.array();
-      fab_size += qgdnvtmp1.nBytes();
+          qgdnvtmp1 = scratch.alloc(sobx, NGDNV);
+          auto qgdnvtmp1_arr = qgdnvtmp1.array();
+          fab_size += qgdnvtmp1.nBytes();
 
 #if AMREX_SPACEDIM == 3
-      qgdnvtmp2.resize(obx, NGDNV);
-      Elixir elix_qgdnvtmp2 = qgdnvtmp2.elixir();
-      auto qgdnvtmp2_arr = qgdnvtmp2.array();
-      fab_size += qgdnvtmp2.nBytes();
+          qgdnvtmp2 = scratch.alloc(sobx, NGDNV);
+          auto qgdnvtmp2_arr = qgdnvtmp2.array();
+          fab_size += qgdnvtmp2.nBytes();
 #endif
 
-      ql.resize(obx, NQ);
-      Elixir elix_ql = ql.elixir();
-      auto ql_arr = ql.array();
-      fab_size += ql.nBytes();
+          ql = scratch.alloc<qedge_t>(sobx, NQ);
+          auto ql_arr = ql.array();
+          fab_size += ql.nBytes();
 
-      qr.resize(obx, NQ);
-      Elixir elix_qr = qr.elixir();
-      auto qr_arr = qr.array();
-      fab_size += qr.nBytes();
+          qr = scratch.alloc<qedge_t>(sobx, NQ);
+          auto qr_arr = qr.array();
+          fab_size += qr.nBytes();
 #endif
 
 
 
 #if AMREX_SPACEDIM == 2
 
-      const amrex::Real hdt = 0.5*dt;
-      const amrex::Real hdtdx = 0.5*dt/dx[0];
-      const amrex::Real hdtdy = 0.5*dt/dx[1];
+          const amrex::Real hdt = 0.5*dt;
+          const amrex::Real hdtdx = 0.5*dt/dx[0];
+          const amrex::Real hdtdy = 0.5*dt/dx[1];
 
-      // compute F^x
-      // [lo(1), lo(2)-1, 0], [hi(1)+1, hi(2)+1, 0]
-      const Box& cxbx = amrex::grow(xbx, IntVect(AMREX_D_DECL(0,1,0)));
+          // compute F^x
+          // [lo(1), lo(2)-1, 0], [hi(1)+1, hi(2)+1, 0]
+          const Box& cxbx = amrex::grow(sxbx, IntVect(AMREX_D_DECL(0,1,0)));
 
-      // ftmp1 = fx
-      // rftmp1 = rfx
-      // qgdnvtmp1 = qgdnxv
-      cmpflx_plus_godunov(cxbx,
-                          qxm_arr, qxp_arr,
-                          ftmp1_arr,
+          // ftmp1 = fx
+          // rftmp1 = rfx
+          // qgdnvtmp1 = qgdnxv
+          cmpflx_plus_godunov(cxbx,
+                              qxm_arr, qxp_arr,
+                              ftmp1_arr,
 #ifdef RADIATION
-                          rftmp1_arr,
+                              rftmp1_arr,
 #endif
-                          qgdnvtmp1_arr,
-                          qaux_arr, shk_arr,
-                          0, false);
+                              qgdnvtmp1_arr,
+                              qaux_arr, shk_arr,
+                              0, false);
 
-      // compute F^y
-      // [lo(1)-1, lo(2), 0], [hi(1)+1, hi(2)+1, 0]
-      const Box& cybx = amrex::grow(ybx, IntVect(AMREX_D_DECL(1,0,0)));
+          // compute F^y
+          // [lo(1)-1, lo(2), 0], [hi(1)+1, hi(2)+1, 0]
+          const Box& cybx = amrex::grow(sybx, IntVect(AMREX_D_DECL(1,0,0)));
 
-      // ftmp2 = fy
-      // rftmp2 = rfy
-      cmpflx_plus_godunov(cybx,
-                          qym_arr, qyp_arr,
-                          ftmp2_arr,
+          // ftmp2 = fy
+          // rftmp2 = rfy
+          cmpflx_plus_godunov(cybx,
+                              qym_arr, qyp_arr,
+                              ftmp2_arr,
 #ifdef RADIATION
-                          rftmp2_arr,
-#endif
-                          qey_arr,
-                          qaux_arr, shk_arr,
-                          1, false);
-
-      // add the transverse flux difference in y to the x states
-      // [lo(1), lo(2), 0], [hi(1)+1, hi(2), 0]
-
-      // ftmp2 = fy
-      // rftmp2 = rfy
-      trans_single(xbx, 1, 0,
-                   qxm_arr, ql_arr,
-                   qxp_arr, qr_arr,
-                   qaux_arr,
-                   ftmp2_arr,
+                              rftmp2_arr,
+#endif
+                              qey_arr,
+                              qaux_arr, shk_arr,
+                              1, false);
+
+          // add the transverse flux difference in y to the x states
+          // [lo(1), lo(2), 0], [hi(1)+1, hi(2), 0]
+
+          // ftmp2 = fy
+          // rftmp2 = rfy
+          trans_single(sxbx, 1, 0,
+                       qxm_arr, ql_arr,
+                       qxp_arr, qr_arr,
+                       qaux_arr,
+                       ftmp2_arr,
 #ifdef RADIATION
-                   rftmp2_arr,
+                       rftmp2_arr,
 #endif
-                   qey_arr,
-                   areay_arr,
-                   vol_arr,
-                   hdt, hdtdy);
+                       qey_arr,
+                       areay_arr,
+                       vol_arr,
+                       hdt, hdtdy);
 
-      reset_edge_state_thermo(xbx, ql.array());
+          reset_edge_state_thermo(sxbx, ql.array());
 
-      reset_edge_state_thermo(xbx, qr.array());
+          reset_edge_state_thermo(sxbx, qr.array());
 
-      // solve the final Riemann problem axross the x-interfaces
+          // solve the final Riemann problem axross the x-interfaces
 
 #ifdef PRIM_SPECIES_HAVE_SOURCES
-      add_species_source_to_states(xbx, 0, dt,
-                                   ql_arr, qr_arr, src_q_arr);
+          add_species_source_to_states(sxbx, 0, dt,
+                                       ql_arr, qr_arr, src_q_arr);
 
 #endif
 
-      cmpflx_plus_godunov(xbx,
-                          ql_arr, qr_arr,
-                          flux0_arr,
+          cmpflx_plus_godunov(sxbx,
+                              ql_arr, qr_arr,
+                              flux0_arr,
 #ifdef RADIATION
-                          rad_flux0_arr,
+                              rad_flux0_arr,
 #endif
-                          qex_arr,
-                          qaux_arr, shk_arr,
-                          0, false);
+                              qex_arr,
+                              qaux_arr, shk_arr,
+                              0, false);
+
+          // correct the final x fluxes (artificial viscosity, limiters,
+          // species normalization) while they are still in cache
 
-      // add the transverse flux difference in x to the y states
-      // [lo(1), lo(2), 0], [hi(1), hi(2)+1, 0]
+          clean_hydro_fluxes(sxbx, 0, div_arr, uin_arr, q_arr, vol_arr,
+                             flux0_arr, areax_arr, dt);
 
-      // ftmp1 = fx
-      // rftmp1 = rfx
-      // qgdnvtmp1 = qgdnvx
+          // add the transverse flux difference in x to the y states
+          // [lo(1), lo(2), 0], [hi(1), hi(2)+1, 0]
 
-      trans_single(ybx, 0, 1,
-                   qym_arr, ql_arr,
-                   qyp_arr, qr_arr,
-                   qaux_arr,
-                   ftmp1_arr,
+          // ftmp1 = fx
+          // rftmp1 = rfx
+          // qgdnvtmp1 = qgdnvx
+
+          trans_single(sybx, 0, 1,
+                       qym_arr, ql_arr,
+                       qyp_arr, qr_arr,
+                       qaux_arr,
+                       ftmp1_arr,
 #ifdef RADIATION
-                   rftmp1_arr,
+                       rftmp1_arr,
 #endif
-                   qgdnvtmp1_arr,
-                   areax_arr,
-                   vol_arr,
-                   hdt, hdtdx);
+                       qgdnvtmp1_arr,
+                       areax_arr,
+                       vol_arr,
+                       hdt, hdtdx);
 
-      reset_edge_state_thermo(ybx, ql.array());
+          reset_edge_state_thermo(sybx, ql.array());
 
-      reset_edge_state_thermo(ybx, qr.array());
+          reset_edge_state_thermo(sybx, qr.array());
 
 
-      // solve the final Riemann problem axross the y-interfaces
+          // solve the final Riemann problem axross the y-interfaces
 
 #ifdef PRIM_SPECIES_HAVE_SOURCES
-      add_species_source_to_states(ybx, 1, dt,
-                                   ql_arr, qr_arr, src_q_arr);
+          add_species_source_to_states(sybx, 1, dt,
+                                       ql_arr, qr_arr, src_q_arr);
 
 #endif
 
-      cmpflx_plus_godunov(ybx,
-                          ql_arr, qr_arr,
-                          flux1_arr,
+          cmpflx_plus_godunov(sybx,
+                              ql_arr, qr_arr,
+                              flux1_arr,
 #ifdef RADIATION
-                          rad_flux1_arr,
+                              rad_flux1_arr,
 #endif
-                          qey_arr,
-                          qaux_arr, shk_arr,
-                          1, false);
+                              qey_arr,
+                              qaux_arr, shk_arr,
+                              1, false);
+
+          // correct the final y fluxes (artificial viscosity, limiters,
+          // species normalization) while they are still in cache
+
+          clean_hydro_fluxes(sybx, 1, div_arr, uin_arr, q_arr, vol_arr,
+                             flux1_arr, areay_arr, dt);
 #endif // 2-d
 
 
 
 #if AMREX_SPACEDIM == 3
 
-      const amrex::Real hdt = 0.5*dt;
+          const amrex::Real hdt = 0.5*dt;
 
-      const amrex::Real hdtdx = 0.5*dt/dx[0];
-      const amrex::Real hdtdy = 0.5*dt/dx[1];
-      const amrex::Real hdtdz = 0.5*dt/dx[2];
+          const amrex::Real hdtdx = 0.5*dt/dx[0];
+          const amrex::Real hdtdy = 0.5*dt/dx[1];
+          const amrex::Real hdtdz = 0.5*dt/dx[2];
 
-      const amrex::Real cdtdx = dt/dx[0]/3.0;
-      const amrex::Real cdtdy = dt/dx[1]/3.0;
-      const amrex::Real cdtdz = dt/dx[2]/3.0;
+          const amrex::Real cdtdx = dt/dx[0]/3.0;
+          const amrex::Real cdtdy = dt/dx[1]/3.0;
+          const amrex::Real cdtdz = dt/dx[2]/3.0;
 
-      // compute F^x
-      // [lo(1), lo(2)-1, lo(3)-1], [hi(1)+1, hi(2)+1, hi(3)+1]
-      const Box& cxbx = amrex::grow(xbx, IntVect(AMREX_D_DECL(0,1,1)));
+          // compute F^x
+          // [lo(1), lo(2)-1, lo(3)-1], [hi(1)+1, hi(2)+1, hi(3)+1]
+          const Box& cxbx = amrex::grow(sxbx, IntVect(AMREX_D_DECL(0,1,1)));
 
-      // ftmp1 = fx
-      // rftmp1 = rfx
-      // qgdnvtmp1 = qgdnxv
-      cmpflx_plus_godunov(cxbx,
-                          qxm_arr, qxp_arr,
-                          ftmp1_arr,
+          // ftmp1 = fx
+          // rftmp1 = rfx
+          // qgdnvtmp1 = qgdnxv
+          cmpflx_plus_godunov(cxbx,
+                              qxm_arr, qxp_arr,
+                              ftmp1_arr,
 #ifdef RADIATION
-                          rftmp1_arr,
-#endif
-                          qgdnvtmp1_arr,
-                          qaux_arr, shk_arr,
-                          0, false);
-
-
-      // [lo(1), lo(2), lo(3)-1], [hi(1), hi(2)+1, hi(3)+1]
-      const Box& tyxbx = amrex::grow(ybx, IntVect(AMREX_D_DECL(0,0,1)));
-
-      qmyx.resize(tyxbx, NQ);
-      Elixir elix_qmyx = qmyx.elixir();
-      auto qmyx_arr = qmyx.array();
-      fab_size += qmyx.nBytes();
-
-      qpyx.resize(tyxbx, NQ);
-      Elixir elix_qpyx = qpyx.elixir();
-      auto qpyx_arr = qpyx.array();
-      fab_size += qpyx.nBytes();
-
-      // ftmp1 = fx
-      // rftmp1 = rfx
-      // qgdnvtmp1 = qgdnvx
-      trans_single(tyxbx, 0, 1,
-                   qym_arr, qmyx_arr,
-                   qyp_arr, qpyx_arr,
-                   qaux_arr,
-                   ftmp1_arr,
+                              rftmp1_arr,
+#endif
+                              qgdnvtmp1_arr,
+                              qaux_arr, shk_arr,
+                              0, false);
+
+
+          // [lo(1), lo(2), lo(3)-1], [hi(1), hi(2)+1, hi(3)+1]
+          const Box& tyxbx = amrex::grow(sybx, IntVect(AMREX_D_DECL(0,0,1)));
+
+          qmyx = scratch.alloc<qedge_t>(tyxbx, NQ);
+          auto qmyx_arr = qmyx.array();
+          fab_size += qmyx.nBytes();
+
+          qpyx = scratch.alloc<qedge_t>(tyxbx, NQ);
+          auto qpyx_arr = qpyx.array();
+          fab_size += qpyx.nBytes();
+
+          // [lo(1), lo(2)-1, lo(3)], [hi(1), hi(2)+1, hi(3)+1]
+          const Box& tzxbx = amrex::grow(szbx, IntVect(AMREX_D_DECL(0,1,0)));
+
+          qmzx = scratch.alloc<qedge_t>(tzxbx, NQ);
+          auto qmzx_arr = qmzx.array();
+          fab_size += qmzx.nBytes();
+
+          qpzx = scratch.alloc<qedge_t>(tzxbx, NQ);
+          auto qpzx_arr = qpzx.array();
+          fab_size += qpzx.nBytes();
+
+          // add the transverse x flux difference to the y and z states
+          // ftmp1 = fx
+          // rftmp1 = rfx
+          // qgdnvtmp1 = qgdnvx
+          trans_single_pair(0,
+                            tyxbx, 1,
+                            qym_arr, qmyx_arr,
+                            qyp_arr, qpyx_arr,
+                            tzxbx, 2,
+                            qzm_arr, qmzx_arr,
+                            qzp_arr, qpzx_arr,
+                            qaux_arr,
+                            ftmp1_arr,
 #ifdef RADIATION
-                   rftmp1_arr,
+                            rftmp1_arr,
 #endif
-                   qgdnvtmp1_arr,
-                   hdt, cdtdx);
-
-      reset_edge_state_thermo(tyxbx, qmyx.array());
-
-      reset_edge_state_thermo(tyxbx, qpyx.array());
+                            qgdnvtmp1_arr,
+                            hdt, cdtdx);
 
-      // [lo(1), lo(2)-1, lo(3)], [hi(1), hi(2)+1, hi(3)+1]
-      const Box& tzxbx = amrex::grow(zbx, IntVect(AMREX_D_DECL(0,1,0)));
+          // compute F^y
+          // [lo(1)-1, lo(2), lo(3)-1], [hi(1)+1, hi(2)+1, hi(3)+1]
+          const Box& cybx = amrex::grow(sybx, IntVect(AMREX_D_DECL(1,0,1)));
 
-      qmzx.resize(tzxbx, NQ);
-      Elixir elix_qmzx = qmzx.elixir();
-      auto qmzx_arr = qmzx.array();
-      fab_size += qmzx.nBytes();
-
-      qpzx.resize(tzxbx, NQ);
-      Elixir elix_qpzx = qpzx.elixir();
-      auto qpzx_arr = qpzx.array();
-      fab_size += qpzx.nBytes();
-
-      trans_single(tzxbx, 0, 2,
-                   qzm_arr, qmzx_arr,
-                   qzp_arr, qpzx_arr,
-                   qaux_arr,
-                   ftmp1_arr,
+          // ftmp1 = fy
+          // rftmp1 = rfy
+          // qgdnvtmp1 = qgdnvy
+          cmpflx_plus_godunov(cybx,
+                              qym_arr, qyp_arr,
+                              ftmp1_arr,
+#ifdef RADIATION
+                              rftmp1_arr,
+#endif
+                              qgdnvtmp1_arr,
+                              qaux_arr, shk_arr,
+                              1, false);
+
+          // [lo(1), lo(2), lo(3)-1], [hi(1)+1, hi(2), lo(3)+1]
+          const Box& txybx = amrex::grow(sxbx, IntVect(AMREX_D_DECL(0,0,1)));
+
+          qmxy = scratch.alloc<qedge_t>(txybx, NQ);
+          auto qmxy_arr = qmxy.array();
+          fab_size += qmxy.nBytes();
+
+          qpxy = scratch.alloc<qedge_t>(txybx, NQ);
+          auto qpxy_arr = qpxy.array();
+          fab_size += qpxy.nBytes();
+
+          // [lo(1)-1, lo(2), lo(3)], [hi(1)+1, hi(2), lo(3)+1]
+          const Box& tzybx = amrex::grow(szbx, IntVect(AMREX_D_DECL(1,0,0)));
+
+          qmzy = scratch.alloc<qedge_t>(tzybx, NQ);
+          auto qmzy_arr = qmzy.array();
+          fab_size += qmzy.nBytes();
+
+          qpzy = scratch.alloc<qedge_t>(tzybx, NQ);
+          auto qpzy_arr = qpzy.array();
+          fab_size += qpzy.nBytes();
+
+          // add the transverse y flux difference to the x and z states
+          // ftmp1 = fy
+          // rftmp1 = rfy
+          // qgdnvtmp1 = qgdnvy
+          trans_single_pair(1,
+                            txybx, 0,
+                            qxm_arr, qmxy_arr,
+                            qxp_arr, qpxy_arr,
+                            tzybx, 2,
+                            qzm_arr, qmzy_arr,
+                            qzp_arr, qpzy_arr,
+                            qaux_arr,
+                            ftmp1_arr,
 #ifdef RADIATION
-                   rftmp1_arr,
+                            rftmp1_arr,
 #endif
-                   qgdnvtmp1_arr,
-                   hdt, cdtdx);
-
-      reset_edge_state_thermo(tzxbx, qmzx.array());
-
-      reset_edge_state_thermo(tzxbx, qpzx.array());
+                            qgdnvtmp1_arr,
+                            hdt, cdtdy);
 
-      // compute F^y
-      // [lo(1)-1, lo(2), lo(3)-1], [hi(1)+1, hi(2)+1, hi(3)+1]
-      const Box& cybx = amrex::grow(ybx, IntVect(AMREX_D_DECL(1,0,1)));
+          // compute F^z
+          // [lo(1)-1, lo(2)-1, lo(3)], [hi(1)+1, hi(2)+1, hi(3)+1]
+          const Box& czbx = amrex::grow(szbx, IntVect(AMREX_D_DECL(1,1,0)));
 
-      // ftmp1 = fy
-      // rftmp1 = rfy
-      // qgdnvtmp1 = qgdnvy
-      cmpflx_plus_godunov(cybx,
-                          qym_arr, qyp_arr,
-                          ftmp1_arr,
+          // ftmp1 = fz
+          // rftmp1 = rfz
+          // qgdnvtmp1 = qgdnvz
+          cmpflx_plus_godunov(czbx,
+                              qzm_arr, qzp_arr,
+                              ftmp1_arr,
 #ifdef RADIATION
-                          rftmp1_arr,
-#endif
-                          qgdnvtmp1_arr,
-                          qaux_arr, shk_arr,
-                          1, false);
-
-      // [lo(1), lo(2), lo(3)-1], [hi(1)+1, hi(2), lo(3)+1]
-      const Box& txybx = amrex::grow(xbx, IntVect(AMREX_D_DECL(0,0,1)));
-
-      qmxy.resize(txybx, NQ);
-      Elixir elix_qmxy = qmxy.elixir();
-      auto qmxy_arr = qmxy.array();
-      fab_size += qmxy.nBytes();
-
-      qpxy.resize(txybx, NQ);
-      Elixir elix_qpxy = qpxy.elixir();
-      auto qpxy_arr = qpxy.array();
-      fab_size += qpxy.nBytes();
-
-      // ftmp1 = fy
-      // rftmp1 = rfy
-      // qgdnvtmp1 = qgdnvy
-      trans_single(txybx, 1, 0,
-                   qxm_arr, qmxy_arr,
-                   qxp_arr, qpxy_arr,
-                   qaux_arr,
-                   ftmp1_arr,
+                              rftmp1_arr,
+#endif
+                              qgdnvtmp1_arr,
+                              qaux_arr, shk_arr,
+                              2, false);
+
+          // [lo(1)-1, lo(2)-1, lo(3)], [hi(1)+1, hi(2)+1, lo(3)]
+          const Box& txzbx = amrex::grow(sxbx, IntVect(AMREX_D_DECL(0,1,0)));
+
+          qmxz = scratch.alloc<qedge_t>(txzbx, NQ);
+          auto qmxz_arr = qmxz.array();
+          fab_size += qmxz.nBytes();
+
+          qpxz = scratch.alloc<qedge_t>(txzbx, NQ);
+          auto qpxz_arr = qpxz.array();
+          fab_size += qpxz.nBytes();
+
+          // [lo(1)-1, lo(2), lo(3)], [hi(1)+1, hi(2)+1, lo(3)]
+          const Box& tyzbx = amrex::grow(sybx, IntVect(AMREX_D_DECL(1,0,0)));
+
+          qmyz = scratch.alloc<qedge_t>(tyzbx, NQ);
+          auto qmyz_arr = qmyz.array();
+          fab_size += qmyz.nBytes();
+
+          qpyz = scratch.alloc<qedge_t>(tyzbx, NQ);
+          auto qpyz_arr = qpyz.array();
+          fab_size += qpyz.nBytes();
+
+          // add the transverse z flux difference to the x and y states
+          // ftmp1 = fz
+          // rftmp1 = rfz
+          // qgdnvtmp1 = qgdnvz
+          trans_single_pair(2,
+                            txzbx, 0,
+                            qxm_arr, qmxz_arr,
+                            qxp_arr, qpxz_arr,
+                            tyzbx, 1,
+                            qym_arr, qmyz_arr,
+                            qyp_arr, qpyz_arr,
+                            qaux_arr,
+                            ftmp1_arr,
 #ifdef RADIATION
-                   rftmp1_arr,
+                            rftmp1_arr,
 #endif
-                   qgdnvtmp1_arr,
-                   hdt, cdtdy);
+                            qgdnvtmp1_arr,
+                            hdt, cdtdz);
 
-      reset_edge_state_thermo(txybx, qmxy.array());
+          // we now have q?zx, q?yx, q?zy, q?xy, q?yz, q?xz
 
-      reset_edge_state_thermo(txybx, qpxy.array());
+          //
+          // Use qx?, q?yz, q?zy to compute final x-flux
+          //
 
-      // [lo(1)-1, lo(2), lo(3)], [hi(1)+1, hi(2), lo(3)+1]
-      const Box& tzybx = amrex::grow(zbx, IntVect(AMREX_D_DECL(1,0,0)));
+          // compute F^{y|z}
+          // [lo(1)-1, lo(2), lo(3)], [hi(1)+1, hi(2)+1, hi(3)]
+          const Box& cyzbx = amrex::grow(sybx, IntVect(AMREX_D_DECL(1,0,0)));
 
-      qmzy.resize(tzybx, NQ);
-      Elixir elix_qmzy = qmzy.elixir();
-      auto qmzy_arr = qmzy.array();
-      fab_size += qmzy.nBytes();
-
-      qpzy.resize(tzybx, NQ);
-      Elixir elix_qpzy = qpzy.elixir();
-      auto qpzy_arr = qpzy.array();
-      fab_size += qpzy.nBytes();
-
-      // ftmp1 = fy
-      // rftmp1 = rfy
-      // qgdnvtmp1 = qgdnvy
-      trans_single(tzybx, 1, 2,
-                   qzm_arr, qmzy_arr,
-                   qzp_arr, qpzy_arr,
-                   qaux_arr,
-                   ftmp1_arr,
+          // ftmp1 = fyz
+          // rftmp1 = rfyz
+          // qgdnvtmp1 = qgdnvyz
+          cmpflx_plus_godunov(cyzbx,
+                              qmyz_arr, qpyz_arr,
+                              ftmp1_arr,
+#ifdef RADIATION
+                              rftmp1_arr,
+#endif
+                              qgdnvtmp1_arr,
+                              qaux_arr, shk_arr,
+                              1, false);
+
+          // compute F^{z|y}
+          // [lo(1)-1, lo(2), lo(3)], [hi(1)+1, hi(2), hi(3)+1]
+          const Box& czybx = amrex::grow(szbx, IntVect(AMREX_D_DECL(1,0,0)));
+
+          // ftmp2 = fzy
+          // rftmp2 = rfzy
+          // qgdnvtmp2 = qgdnvzy
+          cmpflx_plus_godunov(czybx,
+                              qmzy_arr, qpzy_arr,
+                              ftmp2_arr,
 #ifdef RADIATION
-                   rftmp1_arr,
+                              rftmp2_arr,
 #endif
-                   qgdnvtmp1_arr,
-                   hdt, cdtdy);
+                              qgdnvtmp2_arr,
+                              qaux_arr, shk_arr,
+                              2, false);
 
-      reset_edge_state_thermo(tzybx, qmzy.array());
+          // compute the corrected x interface states and fluxes
+          // [lo(1), lo(2), lo(3)], [hi(1)+1, hi(2), hi(3)]
 
-      reset_edge_state_thermo(tzybx, qpzy.array());
-
-      // compute F^z
-      // [lo(1)-1, lo(2)-1, lo(3)], [hi(1)+1, hi(2)+1, hi(3)+1]
-      const Box& czbx = amrex::grow(zbx, IntVect(AMREX_D_DECL(1,1,0)));
-
-      // ftmp1 = fz
-      // rftmp1 = rfz
-      // qgdnvtmp1 = qgdnvz
-      cmpflx_plus_godunov(czbx,
-                          qzm_arr, qzp_arr,
-                          ftmp1_arr,
+          trans_final(sxbx, 0, 1, 2,
+                      qxm_arr, ql_arr,
+                      qxp_arr, qr_arr,
+                      qaux_arr,
+                      ftmp1_arr,
 #ifdef RADIATION
-                          rftmp1_arr,
-#endif
-                          qgdnvtmp1_arr,
-                          qaux_arr, shk_arr,
-                          2, false);
-
-      // [lo(1)-1, lo(2)-1, lo(3)], [hi(1)+1, hi(2)+1, lo(3)]
-      const Box& txzbx = amrex::grow(xbx, IntVect(AMREX_D_DECL(0,1,0)));
-
-      qmxz.resize(txzbx, NQ);
-      Elixir elix_qmxz = qmxz.elixir();
-      auto qmxz_arr = qmxz.array();
-      fab_size += qmxz.nBytes();
-
-      qpxz.resize(txzbx, NQ);
-      Elixir elix_qpxz = qpxz.elixir();
-      auto qpxz_arr = qpxz.array();
-      fab_size += qpxz.nBytes();
-
-      // ftmp1 = fz
-      // rftmp1 = rfz
-      // qgdnvtmp1 = qgdnvz
-      trans_single(txzbx, 2, 0,
-                   qxm_arr, qmxz_arr,
-                   qxp_arr, qpxz_arr,
-                   qaux_arr,
-                   ftmp1_arr,
+                      rftmp1_arr,
+#endif
+                      ftmp2_arr,
 #ifdef RADIATION
-                   rftmp1_arr,
+                      rftmp2_arr,
 #endif
-                   qgdnvtmp1_arr,
-                   hdt, cdtdz);
+                      qgdnvtmp1_arr,
+                      qgdnvtmp2_arr,
+                      hdtdy, hdtdz);
 
-      reset_edge_state_thermo(txzbx, qmxz.array());
+          reset_edge_state_thermo(sxbx, ql.array());
 
-      reset_edge_state_thermo(txzbx, qpxz.array());
+          reset_edge_state_thermo(sxbx, qr.array());
 
-      // [lo(1)-1, lo(2), lo(3)], [hi(1)+1, hi(2)+1, lo(3)]
-      const Box& tyzbx = amrex::grow(ybx, IntVect(AMREX_D_DECL(1,0,0)));
+#ifdef PRIM_SPECIES_HAVE_SOURCES
+          add_species_source_to_states(sxbx, 0, dt,
+                                       ql_arr, qr_arr, src_q_arr);
 
-      qmyz.resize(tyzbx, NQ);
-      Elixir elix_qmyz = qmyz.elixir();
-      auto qmyz_arr = qmyz.array();
-      fab_size += qmyz.nBytes();
+#endif
 
-      qpyz.resize(tyzbx, NQ);
-      Elixir elix_qpyz = qpyz.elixir();
-      auto qpyz_arr = qpyz.array();
-      fab_size += qpyz.nBytes();
 
-      // ftmp1 = fz
-      // rftmp1 = rfz
-      // qgdnvtmp1 = qgdnvz
-      trans_single(tyzbx, 2, 1,
-                   qym_arr, qmyz_arr,
-                   qyp_arr, qpyz_arr,
-                   qaux_arr,
-                   ftmp1_arr,
+          cmpflx_plus_godunov(sxbx,
+                              ql_arr, qr_arr,
+                              flux0_arr,
 #ifdef RADIATION
-                   rftmp1_arr,
+                              rad_flux0_arr,
 #endif
-                   qgdnvtmp1_arr,
-                   hdt, cdtdz);
-
-      reset_edge_state_thermo(tyzbx, qmyz.array());
+                              qex_arr,
+                              qaux_arr, shk_arr,
+                              0, false);
 
-      reset_edge_state_thermo(tyzbx, qpyz.array());
+          // correct the final x fluxes (artificial viscosity, limiters,
+          // species normalization) while they are still in cache
 
-      // we now have q?zx, q?yx, q?zy, q?xy, q?yz, q?xz
+          clean_hydro_fluxes(sxbx, 0, div_arr, uin_arr, q_arr, vol_arr,
+                             flux0_arr, areax_arr, dt);
 
-      //
-      // Use qx?, q?yz, q?zy to compute final x-flux
-      //
+          //
+          // Use qy?, q?zx, q?xz to compute final y-flux
+          //
 
-      // compute F^{y|z}
-      // [lo(1)-1, lo(2), lo(3)], [hi(1)+1, hi(2)+1, hi(3)]
-      const Box& cyzbx = amrex::grow(ybx, IntVect(AMREX_D_DECL(1,0,0)));
+          // compute F^{z|x}
+          // [lo(1), lo(2)-1, lo(3)], [hi(1), hi(2)+1, hi(3)+1]
+          const Box& czxbx = amrex::grow(szbx, IntVect(AMREX_D_DECL(0,1,0)));
 
-      // ftmp1 = fyz
-      // rftmp1 = rfyz
-      // qgdnvtmp1 = qgdnvyz
-      cmpflx_plus_godunov(cyzbx,
-                          qmyz_arr, qpyz_arr,
-                          ftmp1_arr,
+          // ftmp1 = fzx
+          // rftmp1 = rfzx
+          // qgdnvtmp1 = qgdnvzx
+          cmpflx_plus_godunov(czxbx,
+                              qmzx_arr, qpzx_arr,
+                              ftmp1_arr,
 #ifdef RADIATION
-                          rftmp1_arr,
-#endif
-                          qgdnvtmp1_arr,
-                          qaux_arr, shk_arr,
-                          1, false);
-
-      // compute F^{z|y}
-      // [lo(1)-1, lo(2), lo(3)], [hi(1)+1, hi(2), hi(3)+1]
-      const Box& czybx = amrex::grow(zbx, IntVect(AMREX_D_DECL(1,0,0)));
-
-      // ftmp2 = fzy
-      // rftmp2 = rfzy
-      // qgdnvtmp2 = qgdnvzy
-      cmpflx_plus_godunov(czybx,
-                          qmzy_arr, qpzy_arr,
-                          ftmp2_arr,
+                              rftmp1_arr,
+#endif
+                              qgdnvtmp1_arr,
+                              qaux_arr, shk_arr,
+                              2, false);
+
+          // compute F^{x|z}
+          // [lo(1), lo(2)-1, lo(3)], [hi(1)+1, hi(2)+1, hi(3)]
+          const Box& cxzbx = amrex::grow(sxbx, IntVect(AMREX_D_DECL(0,1,0)));
+
+          // ftmp2 = fxz
+          // rftmp2 = rfxz
+          // qgdnvtmp2 = qgdnvxz
+          cmpflx_plus_godunov(cxzbx,
+                              qmxz_arr, qpxz_arr,
+                              ftmp2_arr,
 #ifdef RADIATION
-                          rftmp2_arr,
+                              rftmp2_arr,
 #endif
-                          qgdnvtmp2_arr,
-                          qaux_arr, shk_arr,
-                          2, false);
+                              qgdnvtmp2_arr,
+                              qaux_arr, shk_arr,
+                              0, false);
 
-      // compute the corrected x interface states and fluxes
-      // [lo(1), lo(2), lo(3)], [hi(1)+1, hi(2), hi(3)]
+          // Compute the corrected y interface states and fluxes
+          // [lo(1), lo(2), lo(3)], [hi(1), hi(2)+1, hi(3)]
 
-      trans_final(xbx, 0, 1, 2,
-                  qxm_arr, ql_arr,
-                  qxp_arr, qr_arr,
-                  qaux_arr,
-                  ftmp1_arr,
+          trans_final(sybx, 1, 0, 2,
+                      qym_arr, ql_arr,
+                      qyp_arr, qr_arr,
+                      qaux_arr,
+                      ftmp2_arr,
 #ifdef RADIATION
-                  rftmp1_arr,
+                      rftmp2_arr,
 #endif
-                  ftmp2_arr,
+                      ftmp1_arr,
 #ifdef RADIATION
-                  rftmp2_arr,
+                      rftmp1_arr,
 #endif
-                  qgdnvtmp1_arr,
-                  qgdnvtmp2_arr,
-                  hdtdy, hdtdz);
+                      qgdnvtmp2_arr,
+                      qgdnvtmp1_arr,
+                      hdtdx, hdtdz);
 
-      reset_edge_state_thermo(xbx, ql.array());
+          reset_edge_state_thermo(sybx, ql.array());
 
-      reset_edge_state_thermo(xbx, qr.array());
+          reset_edge_state_thermo(sybx, qr.array());
 
 #ifdef PRIM_SPECIES_HAVE_SOURCES
-      add_species_source_to_states(xbx, 0, dt,
-                                   ql_arr, qr_arr, src_q_arr);
+          add_species_source_to_states(sybx, 1, dt,
+                                       ql_arr, qr_arr, src_q_arr);
 
 #endif
 
 
-      cmpflx_plus_godunov(xbx,
-                          ql_arr, qr_arr,
-                          flux0_arr,
+          // Compute the final F^y
+          // [lo(1), lo(2), lo(3)], [hi(1), hi(2)+1, hi(3)]
+          cmpflx_plus_godunov(sybx,
+                              ql_arr, qr_arr,
+                              flux1_arr,
 #ifdef RADIATION
-                          rad_flux0_arr,
-#endif
-                          qex_arr,
-                          qaux_arr, shk_arr,
-                          0, false);
-
-      //
-      // Use qy?, q?zx, q?xz to compute final y-flux
-      //
-
-      // compute F^{z|x}
-      // [lo(1), lo(2)-1, lo(3)], [hi(1), hi(2)+1, hi(3)+1]
-      const Box& czxbx = amrex::grow(zbx, IntVect(AMREX_D_DECL(0,1,0)));
-
-      // ftmp1 = fzx
-      // rftmp1 = rfzx
-      // qgdnvtmp1 = qgdnvzx
-      cmpflx_plus_godunov(czxbx,
-                          qmzx_arr, qpzx_arr,
-                          ftmp1_arr,
-#ifdef RADIATION
-                          rftmp1_arr,
-#endif
-                          qgdnvtmp1_arr,
-                          qaux_arr, shk_arr,
-                          2, false);
-
-      // compute F^{x|z}
-      // [lo(1), lo(2)-1, lo(3)], [hi(1)+1, hi(2)+1, hi(3)]
-      const Box& cxzbx = amrex::grow(xbx, IntVect(AMREX_D_DECL(0,1,0)));
-
-      // ftmp2 = fxz
-      // rftmp2 = rfxz
-      // qgdnvtmp2 = qgdnvxz
-      cmpflx_plus_godunov(cxzbx,
-                          qmxz_arr, qpxz_arr,
-                          ftmp2_arr,
-#ifdef RADIATION
-                          rftmp2_arr,
+                              rad_flux1_arr,
 #endif
-                          qgdnvtmp2_arr,
-                          qaux_arr, shk_arr,
-                          0, false);
+                              qey_arr,
+                              qaux_arr, shk_arr,
+                              1, false);
 
-      // Compute the corrected y interface states and fluxes
-      // [lo(1), lo(2), lo(3)], [hi(1), hi(2)+1, hi(3)]
+          // correct the final y fluxes (artificial viscosity, limiters,
+          // species normalization) while they are still in cache
 
-      trans_final(ybx, 1, 0, 2,
-                  qym_arr, ql_arr,
-                  qyp_arr, qr_arr,
-                  qaux_arr,
-                  ftmp2_arr,
-#ifdef RADIATION
-                  rftmp2_arr,
-#endif
-                  ftmp1_arr,
-#ifdef RADIATION
-                  rftmp1_arr,
-#endif
-                  qgdnvtmp2_arr,
-                  qgdnvtmp1_arr,
-                  hdtdx, hdtdz);
+          clean_hydro_fluxes(sybx, 1, div_arr, uin_arr, q_arr, vol_arr,
+                             flux1_arr, areay_arr, dt);
 
-      reset_edge_state_thermo(ybx, ql.array());
+          //
+          // Use qz?, q?xy, q?yx to compute final z-flux
+          //
 
-      reset_edge_state_thermo(ybx, qr.array());
+          // compute F^{x|y}
+          // [lo(1), lo(2), lo(3)-1], [hi(1)+1, hi(2), hi(3)+1]
+          const Box& cxybx = amrex::grow(sxbx, IntVect(AMREX_D_DECL(0,0,1)));
 
-#ifdef PRIM_SPECIES_HAVE_SOURCES
-      add_species_source_to_states(ybx, 1, dt,
-                                   ql_arr, qr_arr, src_q_arr);
-
-#endif
-
-
-      // Compute the final F^y
-      // [lo(1), lo(2), lo(3)], [hi(1), hi(2)+1, hi(3)]
-      cmpflx_plus_godunov(ybx,
-                          ql_arr, qr_arr,
-                          flux1_arr,
-#ifdef RADIATION
-                          rad_flux1_arr,
-#endif
-                          qey_arr,
-                          qaux_arr, shk_arr,
-                          1, false);
-
-      //
-      // Use qz?, q?xy, q?yx to compute final z-flux
-      //
-
-      // compute F^{x|y}
-      // [lo(1), lo(2), lo(3)-1], [hi(1)+1, hi(2), hi(3)+1]
-      const Box& cxybx = amrex::grow(xbx, IntVect(AMREX_D_DECL(0,0,1)));
-
-      // ftmp1 = fxy
-      // rftmp1 = rfxy
-      // qgdnvtmp1 = qgdnvxy
-      cmpflx_plus_godunov(cxybx,
-                          qmxy_arr, qpxy_arr,
-                          ftmp1_arr,
+          // ftmp1 = fxy
+          // rftmp1 = rfxy
+          // qgdnvtmp1 = qgdnvxy
+          cmpflx_plus_godunov(cxybx,
+                              qmxy_arr, qpxy_arr,
+                              ftmp1_arr,
 #ifdef RADIATION
-                          rftmp1_arr,
-#endif
-                          qgdnvtmp1_arr,
-                          qaux_arr, shk_arr,
-                          0, false);
-
-      // compute F^{y|x}
-      // [lo(1), lo(2), lo(3)-1], [hi(1), hi(2)+dg(2), hi(3)+1]
-      const Box& cyxbx = amrex::grow(ybx, IntVect(AMREX_D_DECL(0,0,1)));
-
-      // ftmp2 = fyx
-      // rftmp2 = rfyx
-      // qgdnvtmp2 = qgdnvyx
-      cmpflx_plus_godunov(cyxbx,
-                          qmyx_arr, qpyx_arr,
-                          ftmp2_arr,
+                              rftmp1_arr,
+#endif
+                              qgdnvtmp1_arr,
+                              qaux_arr, shk_arr,
+                              0, false);
+
+          // compute F^{y|x}
+          // [lo(1), lo(2), lo(3)-1], [hi(1), hi(2)+dg(2), hi(3)+1]
+          const Box& cyxbx = amrex::grow(sybx, IntVect(AMREX_D_DECL(0,0,1)));
+
+          // ftmp2 = fyx
+          // rftmp2 = rfyx
+          // qgdnvtmp2 = qgdnvyx
+          cmpflx_plus_godunov(cyxbx,
+                              qmyx_arr, qpyx_arr,
+                              ftmp2_arr,
 #ifdef RADIATION
-                          rftmp2_arr,
+                              rftmp2_arr,
 #endif
-                          qgdnvtmp2_arr,
-                          qaux_arr, shk_arr,
-                          1, false);
+                              qgdnvtmp2_arr,
+                              qaux_arr, shk_arr,
+                              1, false);
 
-      // compute the corrected z interface states and fluxes
-      // [lo(1), lo(2), lo(3)], [hi(1), hi(2), hi(3)+1]
+          // compute the corrected z interface states and fluxes
+          // [lo(1), lo(2), lo(3)], [hi(1), hi(2), hi(3)+1]
 
-      trans_final(zbx, 2, 0, 1,
-                  qzm_arr, ql_arr,
-                  qzp_arr, qr_arr,
-                  qaux_arr,
-                  ftmp1_arr,
+          trans_final(szbx, 2, 0, 1,
+                      qzm_arr, ql_arr,
+                      qzp_arr, qr_arr,
+                      qaux_arr,
+                      ftmp1_arr,
 #ifdef RADIATION
-                  rftmp1_arr,
+                      rftmp1_arr,
 #endif
-                  ftmp2_arr,
+                      ftmp2_arr,
 #ifdef RADIATION
-                  rftmp2_arr,
+                      rftmp2_arr,
 #endif
-                  qgdnvtmp1_arr,
-                  qgdnvtmp2_arr,
-                  hdtdx, hdtdy);
+                      qgdnvtmp1_arr,
+                      qgdnvtmp2_arr,
+                      hdtdx, hdtdy);
 
-      reset_edge_state_thermo(zbx, ql.array());
+          reset_edge_state_thermo(szbx, ql.array());
 
-      reset_edge_state_thermo(zbx, qr.array());
+          reset_edge_state_thermo(szbx, qr.array());
 
 #ifdef PRIM_SPECIES_HAVE_SOURCES
-      add_species_source_to_states(zbx, 2, dt,
-                                   ql_arr, qr_arr, src_q_arr);
+          add_species_source_to_states(szbx, 2, dt,
+                                       ql_arr, qr_arr, src_q_arr);
 
 #endif
 
-      // compute the final z fluxes F^z
-      // [lo(1), lo(2), lo(3)], [hi(1), hi(2), hi(3)+1]
+          // compute the final z fluxes F^z
+          // [lo(1), lo(2), lo(3)], [hi(1), hi(2), hi(3)+1]
 
-      cmpflx_plus_godunov(zbx,
-                          ql_arr, qr_arr,
-                          flux2_arr,
+          cmpflx_plus_godunov(szbx,
+                              ql_arr, qr_arr,
+                              flux2_arr,
 #ifdef RADIATION
-                          rad_flux2_arr,
+                              rad_flux2_arr,
 #endif
-                          qez_arr,
-                          qaux_arr, shk_arr,
-                          2, false);
+                              qez_arr,
+                              qaux_arr, shk_arr,
+                              2, false);
+
+          // correct the final z fluxes (artificial viscosity, limiters,
+          // species normalization) while they are still in cache
+
+          clean_hydro_fluxes(szbx, 2, div_arr, uin_arr, q_arr, vol_arr,
+                             flux2_arr, areaz_arr, dt);
 
 #endif // 3-d
 
+          scratch.release(slab_mark);
 
+        } // slab loop
 
-      // clean the fluxes
+        // tally the CG / CGF dispatch once per interface of the tile --
+        // the transverse and ghost-plane solves in the slab loop revisit
+        // the same interfaces, so we don't count inside the solver.  The
+        // shock flag is valid on all of obx once every slab has run.
 
-      for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
+        if (riemann_solver == 1 && riemann_cg_shocks_only == 1 && verbose > 0) {
+            for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
+                count_riemann_dispatch(amrex::surroundingNodes(bx, idir), idir, shk_arr);
+            }
+        }
 
-          const Box& nbx = amrex::surroundingNodes(bx, idir);
+      } // uniform_tile
 
-          Array4<Real> const flux_arr = (flux[idir]).array();
-          Array4<Real const> const uin_arr = Sborder.array(mfi);
+#ifdef RADIATION
+      // the hydro fluxes were cleaned as they were computed, but we still
+      // need the artificial viscosity on the radiation fluxes
 
-          // Zero out shock and temp fluxes -- these are physically meaningless here
-          amrex::ParallelFor(nbx,
-          [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
-          {
-              flux_arr(i,j,k,UTEMP) = 0.e0;
-#ifdef SHOCK_VAR
-              flux_arr(i,j,k,USHK) = 0.e0;
-#endif
-          });
+      for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
 
-          apply_av(nbx, idir, div_arr, uin_arr, flux_arr);
+          const Box& nbx = amrex::surroundingNodes(bx, idir);
 
-#ifdef RADIATION
           Array4<Real> const rad_flux_arr = (rad_flux[idir]).array();
           Array4<Real const> const Erin_arr = Erborder.array(mfi);
 
           apply_av_rad(nbx, idir, div_arr, Erin_arr, rad_flux_arr);
-#endif
-
-          if (limit_fluxes_on_small_dens == 1) {
-              limit_hydro_fluxes_on_small_dens
-                  (nbx, idir,
-                   Sborder.array(mfi),
-                   q.array(),
-                   volume.array(mfi),
-                   flux[idir].array(),
-                   area[idir].array(mfi),
-                   dt);
-          }
-
-          if (limit_fluxes_on_large_vel == 1) {
-              limit_hydro_fluxes_on_large_vel
-                  (nbx, idir,
-                   Sborder.array(mfi),
-                   q.array(),
-                   volume.array(mfi),
-                   flux[idir].array(),
-                   area[idir].array(mfi),
-                   dt);
-          }
-
-          normalize_species_fluxes(nbx, flux_arr);
 
       }
-
-
+#endif
 
       // conservative update
       Array4<Real> const update_arr = S_new.array(mfi);
@@ -1325,6 +1465,16 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
 #endif
 
 
+      // Store the fluxes from this advance. For simplified SDC integration we
+      // only need to do this on the last iteration.
+
+      bool add_fluxes = true;
+
+      if (time_integration_method == SimplifiedSpectralDeferredCorrections &&
+          sdc_iteration != sdc_iters - 1) {
+          add_fluxes = false;
+      }
+
       for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
 
         const Box& nbx = amrex::surroundingNodes(bx, idir);
@@ -1332,11 +1482,38 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
         Array4<Real> const flux_arr = (flux[idir]).array();
         Array4<Real const> const area_arr = (area[idir]).array(mfi);
 
-        scale_flux(nbx,
+        // Scale the fluxes by dt * area and store them in the same pass.
+        // nbx includes the high face of the tile, which belongs to the
+        // neighboring tile, so we only store on the nodal tilebox.
+        // mass_fluxes is a copy, not an add, since we need it to be
+        // only this subcycle's data when we evaluate the gravitational
+        // forces.
+
+        const Box& ntbx = mfi.nodaltilebox(idir);
+
+        Array4<Real> const fluxes_fab = (*fluxes[idir]).array(mfi);
+        Array4<Real> const mass_fluxes_fab = (*mass_fluxes[idir]).array(mfi);
+
+        amrex::ParallelFor(nbx,
+        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+        {
+            scale_face_flux(i, j, k,
 #if AMREX_SPACEDIM == 1
-                   qex_arr,
+                            qex_arr, coord,
 #endif
-                   flux_arr, area_arr, dt);
+                            flux_arr, area_arr, dt);
+
+            if (ntbx.contains(IntVect(AMREX_D_DECL(i, j, k)))) {
+
+                if (add_fluxes) {
+                    for (int n = 0; n < NUM_STATE; ++n) {
+                        fluxes_fab(i,j,k,n) += flux_arr(i,j,k,n);
+                    }
+                }
+
+                mass_fluxes_fab(i,j,k,0) = flux_arr(i,j,k,URHO);
+            }
+        });
 
 #ifdef RADIATION
         Array4<Real> const rad_flux_arr = (rad_flux[idir]).array();
@@ -1366,27 +1543,8 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
 #endif
         }
 
-        // Store the fluxes from this advance. For simplified SDC integration we
-        // only need to do this on the last iteration.
-
-        bool add_fluxes = true;
-
-        if (time_integration_method == SimplifiedSpectralDeferredCorrections &&
-            sdc_iteration != sdc_iters - 1) {
-            add_fluxes = false;
-        }
-
         if (add_fluxes) {
 
-            Array4<Real> const flux_fab = (flux[idir]).array();
-            Array4<Real> fluxes_fab = (*fluxes[idir]).array(mfi);
-
-            amrex::ParallelFor(mfi.nodaltilebox(idir), NUM_STATE,
-            [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k, int n)
-            {
-                fluxes_fab(i,j,k,n) += flux_fab(i,j,k,n);
-            });
-
 #ifdef RADIATION
             Array4<Real> const rad_flux_fab = (rad_flux[idir]).array();
             Array4<Real> rad_fluxes_fab = (*rad_fluxes[idir]).array(mfi);
@@ -1419,19 +1577,6 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
 
         } // add_fluxes
 
-        Array4<Real> const flux_fab = (flux[idir]).array();
-        Array4<Real> mass_fluxes_fab = (*mass_fluxes[idir]).array(mfi);
-
-        amrex::ParallelFor(mfi.nodaltilebox(idir),
-        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
-        {
-            // This is a copy, not an add, since we need mass_fluxes to be
-            // only this subcycle's data when we evaluate the gravitational
-            // forces.
-
-            mass_fluxes_fab(i,j,k,0) = flux_fab(i,j,k,URHO);
-        });
-
       } // idir loop
 
 #ifdef AMREX_USE_GPU
@@ -1476,6 +1621,7 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
 #endif
       }
 
+      record_box_cost(mfi.index(), box_start_time);
 
     } // MFIter loop
 
@@ -1503,6 +1649,34 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
   }
 #endif
 
+  if (riemann_solver == 1 && riemann_cg_shocks_only == 1 && verbose > 0) {
+      report_riemann_dispatch();
+  }
+
+  if (hydro_skip_uniform_tiles == 1 && verbose > 0) {
+#ifdef BL_LAZY
+    Lazy::QueueReduction( [=] () mutable {
+#endif
+       ParallelDescriptor::ReduceLongSum(num_uniform_tiles, ParallelDescriptor::IOProcessorNumber());
+       ParallelDescriptor::ReduceLongSum(num_tiles, ParallelDescriptor::IOProcessorNumber());
+       if (ParallelDescriptor::IOProcessor()) {
+         std::cout << "... skipped the hydro update on " << num_uniform_tiles
+                   << " of " << num_tiles << " tiles on level " << level
+                   << " (uniform state at rest)" << std::endl;
+       }
+#ifdef BL_LAZY
+     });
+#endif
+  }
+
+  if (harvest_estdt) {
+      EstdtReduceTuple hv = estdt_reduce_data.value();
+      hydro_estdt_harvest = amrex::get<0>(hv);
+      hydro_estdt_harvest_valid = true;
+  }
+
+  record_tile_timing(hydro_tile_tuner[level], strt_time);
+
   if (verbose && ParallelDescriptor::IOProcessor())
     std::cout << "... Leaving construct_ctu_hydro_source()" << std::endl << std::endl;
 
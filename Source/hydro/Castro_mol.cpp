@@ -21,8 +21,8 @@ Castro::mol_plm_reconstruct(const Box& bx,
                             Array4<Real const> const& flatn_arr,
                             Array4<Real const> const& src_q_arr,
                             Array4<Real> const& dq,
-                            Array4<Real> const& qm,
-                            Array4<Real> const& qp) {
+                            Array4<qedge_t> const& qm,
+                            Array4<qedge_t> const& qp) {
 
   const auto dx = geom.CellSizeArray();
 
@@ -354,8 +354,8 @@ Castro::mol_ppm_reconstruct(const Box& bx,
                             const int idir,
                             Array4<Real const> const& q_arr,
                             Array4<Real const> const& flatn_arr,
-                            Array4<Real> const& qm,
-                            Array4<Real> const& qp) {
+                            Array4<qedge_t> const& qm,
+                            Array4<qedge_t> const& qp) {
 
   amrex::ParallelFor(bx, NQ,
   [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k, int n)
@@ -29,6 +29,8 @@ Castro::construct_mol_hydro_source(Real time, Real dt, MultiFab& A_update)
 
   const Real strt_time = ParallelDescriptor::second();
 
+  const IntVect tile_size = get_hydro_tile_size();
+
   if (verbose && ParallelDescriptor::IOProcessor()) {
     std::cout << "... construct advection term, SDC iteration: " << sdc_iteration << "; current node: " << current_sdc_node << std::endl;
   }
@@ -64,7 +66,7 @@ Castro::construct_mol_hydro_source(Real time, Real dt, MultiFab& A_update)
     FArrayBox dq;
     FArrayBox src_q;
     FArrayBox shk;
-    FArrayBox qm, qp;
+    BaseFab<qedge_t> qm, qp;
     FArrayBox div;
     FArrayBox q_int;
     FArrayBox q_avg;
@@ -80,8 +82,10 @@ Castro::construct_mol_hydro_source(Real time, Real dt, MultiFab& A_update)
     MultiFab& old_source = get_old_data(Source_Type);
 
     // The fourth order stuff cannot do tiling because of the Laplacian corrections
-    for (MFIter mfi(S_new, (sdc_order == 4) ? no_tile_size : hydro_tile_size); mfi.isValid(); ++mfi)
+    for (MFIter mfi(S_new, (sdc_order == 4) ? no_tile_size : tile_size); mfi.isValid(); ++mfi)
       {
+        const Real box_start_time = box_timer_start();
+
         const Box& bx  = mfi.tilebox();
 
         const Box& obx = amrex::grow(bx, 1);
@@ -103,6 +107,8 @@ Castro::construct_mol_hydro_source(Real time, Real dt, MultiFab& A_update)
 
         if (time_integration_method == SpectralDeferredCorrections) {
           stage_weight = node_weights[current_sdc_node];
+        } else if (time_integration_method == LowStorageRungeKutta) {
+          stage_weight = lsrk_weights[current_lsrk_stage];
         }
 
         // get the flattening coefficient
@@ -136,7 +142,7 @@ Castro::construct_mol_hydro_source(Real time, Real dt, MultiFab& A_update)
         Array4<Real> const shk_arr = shk.array();
 
         // Multidimensional shock detection
-        // Used for the hybrid Riemann solver
+        // Used for the hybrid Riemann solver and riemann_cg_shocks_only
 
 #ifdef SHOCK_VAR
         bool compute_shock = true;
@@ -144,7 +150,7 @@ Castro::construct_mol_hydro_source(Real time, Real dt, MultiFab& A_update)
         bool compute_shock = false;
 #endif
 
-        if (hybrid_riemann == 1 || compute_shock) {
+        if (hybrid_riemann == 1 || riemann_cg_shocks_only == 1 || compute_shock) {
           shock(obx, q_arr, shk_arr);
         }
         else {
@@ -265,6 +271,13 @@ Castro::construct_mol_hydro_source(Real time, Real dt, MultiFab& A_update)
                                 shk_arr,
                                 idir, true);
 
+            // ibx is grown transversely, so only count the interfaces
+            // this tile owns
+
+            if (riemann_solver == 1 && riemann_cg_shocks_only == 1 && verbose > 0) {
+                count_riemann_dispatch(nbx, idir, shk_arr);
+            }
+
             if (do_hydro == 0) {
               amrex::ParallelFor(nbx, NUM_STATE,
               [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k, int n)
@@ -452,11 +465,11 @@ Castro::construct_mol_hydro_source(Real time, Real dt, MultiFab& A_update)
 
           qm.resize(tbx, NQ);
           Elixir elix_qm = qm.elixir();
-          Array4<Real> const qm_arr = qm.array();
+          Array4<qedge_t> const qm_arr = qm.array();
 
           qp.resize(tbx, NQ);
           Elixir elix_qp = qp.elixir();
-          Array4<Real> const qp_arr = qp.array();
+          Array4<qedge_t> const qp_arr = qp.array();
 
           // compute the fluxes and add artificial viscosity
 
@@ -508,6 +521,10 @@ Castro::construct_mol_hydro_source(Real time, Real dt, MultiFab& A_update)
                  qaux_arr, shk_arr,
                  idir, false);
 
+              if (riemann_solver == 1 && riemann_cg_shocks_only == 1 && verbose > 0) {
+                  count_riemann_dispatch(nbx, idir, shk_arr);
+              }
+
               // set UTEMP and USHK fluxes to zero
               Array4<Real const> const uin_arr = Sborder.array(mfi);
 
@@ -703,9 +720,11 @@ Castro::construct_mol_hydro_source(Real time, Real dt, MultiFab& A_update)
 
         // For SDC, we store node 0 the only time we enter here (the
         // first iteration) and we store the other nodes only on the
-        // last iteration.
-        if (time_integration_method == SpectralDeferredCorrections &&
-             (current_sdc_node == 0 || sdc_iteration == sdc_order+sdc_extra-1)) {
+        // last iteration.  For low-storage RK, every stage contributes,
+        // weighted by its share of the final update.
+        if ((time_integration_method == SpectralDeferredCorrections &&
+             (current_sdc_node == 0 || sdc_iteration == sdc_order+sdc_extra-1)) ||
+            time_integration_method == LowStorageRungeKutta) {
 
           for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
 
@@ -735,6 +754,8 @@ Castro::construct_mol_hydro_source(Real time, Real dt, MultiFab& A_update)
 #endif
         }
 
+        record_box_cost(mfi.index(), box_start_time);
+
       } // MFIter loop
 
   }  // end of omp parallel region
@@ -742,10 +763,16 @@ Castro::construct_mol_hydro_source(Real time, Real dt, MultiFab& A_update)
 
   BL_PROFILE_VAR_STOP(CA_UMDRV);
 
+  record_tile_timing(hydro_tile_tuner[level], strt_time);
+
   if (print_update_diagnostics) {
       evaluate_and_print_source_change(A_update, dt, "hydro source");
     }
 
+    if (riemann_solver == 1 && riemann_cg_shocks_only == 1 && verbose > 0) {
+        report_riemann_dispatch();
+    }
+
     if (verbose > 0)
     {
         const int IOProc   = ParallelDescriptor::IOProcessorNumber();
@@ -363,6 +363,77 @@ Castro::shock(const Box& bx,
 }
 
 
+bool
+Castro::uniform_state_at_rest(const Box& bx,
+                              Array4<Real const> const& u) {
+
+  // count the zones that differ from the first zone in the box or
+  // that have any momentum
+
+  const auto lo = amrex::lbound(bx);
+
+  ReduceOps<ReduceOpSum> reduce_op;
+  ReduceData<int> reduce_data(reduce_op);
+  using ReduceTuple = typename decltype(reduce_data)::Type;
+
+  reduce_op.eval(bx, reduce_data,
+  [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept -> ReduceTuple
+  {
+    int nonuniform = 0;
+
+    for (int n = 0; n < NUM_STATE; ++n) {
+      if (u(i,j,k,n) != u(lo.x,lo.y,lo.z,n)) {
+        nonuniform = 1;
+      }
+    }
+
+    if (u(i,j,k,UMX) != 0.0_rt ||
+        u(i,j,k,UMY) != 0.0_rt ||
+        u(i,j,k,UMZ) != 0.0_rt) {
+      nonuniform = 1;
+    }
+
+    return {nonuniform};
+  });
+
+  ReduceTuple hv = reduce_data.value();
+
+  return amrex::get<0>(hv) == 0;
+
+}
+
+
+bool
+Castro::array_is_zero(const Box& bx,
+                      Array4<Real const> const& a) {
+
+  const int ncomp = a.nComp();
+
+  ReduceOps<ReduceOpSum> reduce_op;
+  ReduceData<int> reduce_data(reduce_op);
+  using ReduceTuple = typename decltype(reduce_data)::Type;
+
+  reduce_op.eval(bx, reduce_data,
+  [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept -> ReduceTuple
+  {
+    int nonzero = 0;
+
+    for (int n = 0; n < ncomp; ++n) {
+      if (a(i,j,k,n) != 0.0_rt) {
+        nonzero = 1;
+      }
+    }
+
+    return {nonzero};
+  });
+
+  ReduceTuple hv = reduce_data.value();
+
+  return amrex::get<0>(hv) == 0;
+
+}
+
+
 void
 Castro::divu(const Box& bx,
              Array4<Real const> const& q_arr,
@@ -490,40 +561,12 @@ Castro::apply_av(const Box& bx,
 
   Real diff_coeff = difmag;
 
-  amrex::ParallelFor(bx, NUM_STATE,
-  [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k, int n)
-  {
-
-    if (n == UTEMP) return;
-#ifdef SHOCK_VAR
-    if (n == USHK) return;
-#endif
-
-    Real div1;
-    if (idir == 0) {
-
-      div1 = 0.25_rt * (div(i,j,k) + div(i,j+dg1,k) +
-                        div(i,j,k+dg2) + div(i,j+dg1,k+dg2));
-      div1 = diff_coeff * amrex::min(0.0_rt, div1);
-      div1 = div1 * (uin(i,j,k,n) - uin(i-1,j,k,n));
-
-    } else if (idir == 1) {
-
-      div1 = 0.25_rt * (div(i,j,k) + div(i+1,j,k) +
-                        div(i,j,k+dg2) + div(i+1,j,k+dg2));
-      div1 = diff_coeff * amrex::min(0.0_rt, div1);
-      div1 = div1 * (uin(i,j,k,n) - uin(i,j-dg1,k,n));
-
-    } else {
-
-      div1 = 0.25_rt * (div(i,j,k) + div(i+1,j,k) +
-                        div(i,j+dg1,k) + div(i+1,j+dg1,k));
-      div1 = diff_coeff * amrex::min(0.0_rt, div1);
-      div1 = div1 * (uin(i,j,k,n) - uin(i,j,k-dg2,n));
-
-    }
+  const Real dx_dir = dx[idir];
 
-    flux(i,j,k,n) += dx[idir] * div1;
+  amrex::ParallelFor(bx,
+  [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+  {
+    apply_av_face(i, j, k, idir, div, uin, flux, diff_coeff, dx_dir);
   });
 }
 
@@ -585,30 +628,7 @@ Castro::normalize_species_fluxes(const Box& bx,
   amrex::ParallelFor(bx,
   [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
   {
-
-    Real sum = 0.0_rt;
-
-    for (int n = UFS; n < UFS+NumSpec; n++) {
-      sum += flux(i,j,k,n);
-    }
-
-    Real fac = 1.0_rt;
-
-    // We skip the normalization if the sum is zero or within epsilon.
-    // There can be numerical problems here if the density flux is
-    // approximately zero at the interface but not exactly, resulting in
-    // division by a small number and/or resulting in one of the species
-    // fluxes being negative because of roundoff error. There are also other
-    // terms like artificial viscosity which can cause these problems.
-    // So checking that sum is sufficiently large helps avoid this.
-
-    if (std::abs(sum) > std::numeric_limits<Real>::epsilon() * std::abs(flux(i,j,k,URHO))) {
-      fac = flux(i,j,k,URHO) / sum;
-    }
-
-    for (int n = UFS; n < UFS+NumSpec; n++) {
-      flux(i,j,k,n) = flux(i,j,k,n) * fac;
-    }
+    normalize_species_face_flux(i, j, k, flux);
   });
 }
 
@@ -626,17 +646,14 @@ Castro::scale_flux(const Box& bx,
   const int coord_type = geom.Coord();
 #endif
 
-  amrex::ParallelFor(bx, NUM_STATE,
-  [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k, int n)
+  amrex::ParallelFor(bx,
+  [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
   {
-
-    flux(i,j,k,n) = dt * flux(i,j,k,n) * area_arr(i,j,k);
+    scale_face_flux(i, j, k,
 #if AMREX_SPACEDIM == 1
-    // Correct the momentum flux with the grad p part.
-    if (coord_type == 0 && n == UMX) {
-      flux(i,j,k,n) += dt * area_arr(i,j,k) * qint(i,j,k,GDPRES);
-    }
+                    qint, coord_type,
 #endif
+                    flux, area_arr, dt);
   });
 }
 
@@ -712,181 +729,9 @@ Castro::limit_hydro_fluxes_on_small_dens(const Box& bx,
     amrex::ParallelFor(bx,
     [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
     {
-
-        // Grab the states on either side of the interface we are working with,
-        // depending on which dimension we're currently calling this with.
-
-        GpuArray<Real, NUM_STATE> uR;
-        for (int n = 0; n < NUM_STATE; ++n) {
-            uR[n] = u(i,j,k,n);
-        }
-
-        GpuArray<Real, NQ> qR;
-        for (int n = 0; n < NQ; ++n) {
-            qR[n] = q(i,j,k,n);
-        }
-
-        Real volR = vol(i,j,k);
-
-        GpuArray<int, 3> idxR = {i,j,k};
-
-        GpuArray<Real, NUM_STATE> uL;
-        GpuArray<Real, NQ> qL;
-        Real volL;
-        GpuArray<int, 3> idxL;
-
-        if (idir == 0) {
-
-            for (int n = 0; n < NUM_STATE; ++n) {
-                uL[n] = u(i-1,j,k,n);
-            }
-
-            for (int n = 0; n < NQ; ++n) {
-                qL[n] = q(i-1,j,k,n);
-            }
-
-            volL = vol(i-1,j,k);
-
-            idxL = {i-1,j,k};
-
-        }
-        else if (idir == 1) {
-
-            for (int n = 0; n < NUM_STATE; ++n) {
-                uL[n] = u(i,j-1,k,n);
-            }
-
-            for (int n = 0; n < NQ; ++n) {
-                qL[n] = q(i,j-1,k,n);
-            }
-
-            volL = vol(i,j-1,k);
-
-            idxL = {i,j-1,k};
-
-        }
-        else {
-
-            for (int n = 0; n < NUM_STATE; ++n) {
-                uL[n] = u(i,j,k-1,n);
-            }
-
-            for (int n = 0; n < NQ; ++n) {
-                qL[n] = q(i,j,k-1,n);
-            }
-
-            volL = vol(i,j,k-1);
-
-            idxL = {i,j,k-1};
-
-        }
-
-        // If an adjacent zone has a floor-violating density, set the flux to zero and move on.
-        // At that point, the only thing to do is wait for a reset at a later point.
-
-        if (uR[URHO] < density_floor || uL[URHO] < density_floor) {
-
-            for (int n = 0; n < NUM_STATE; ++n) {
-                flux(i,j,k,n) = 0.0_rt;
-            }
-
-            return;
-        }
-
-        // Construct cell-centered fluxes.
-
-        GpuArray<Real, NUM_STATE> fluxL;
-        dflux(uL, qL, idir, coord, geomdata, idxL, fluxL);
-
-        GpuArray<Real, NUM_STATE> fluxR;
-        dflux(uR, qR, idir, coord, geomdata, idxR, fluxR);
-
-        // Construct the Lax-Friedrichs flux on the interface (Equation 12).
-        // Note that we are using the information from Equation 9 to obtain the
-        // effective maximum wave speed, (|u| + c)_max = CFL / lambda where
-        // lambda = dt/(dx * alpha); alpha = 1 in 1D and may be chosen somewhat
-        // freely in multi-D as long as alpha_x + alpha_y + alpha_z = 1.
-
-        GpuArray<Real, NUM_STATE> fluxLF;
-        for (int n = 0; n < NUM_STATE; ++n) {
-            fluxLF[n] = 0.5_rt * (fluxL[n] + fluxR[n] + (lcfl / dtdx / alpha) * (uL[n] - uR[n]));
-        }
-
-        // Coefficients of fluxes on either side of the interface.
-
-        Real flux_coefR = 2.0_rt * (dt / alpha) * area_arr(i,j,k) / volR;
-        Real flux_coefL = 2.0_rt * (dt / alpha) * area_arr(i,j,k) / volL;
-
-        // Obtain the one-sided update to the density, based on Hu et al., Eq. 11.
-        // If we would violate the floor, then we need to limit the flux. Since the
-        // flux adds to the density on one side and subtracts from the other, the floor
-        // can only be violated in at most one direction, so we'll do an if-else test
-        // below. This means that we can simplify the approach of Hu et al. -- whereas
-        // they constructed two thetas for each interface (corresponding to either side)
-        // we can complete the operation in one step with a single theta.
-
-        Real drhoL = flux_coefL * flux(i,j,k,URHO);
-        Real rhoL = uL[URHO] - drhoL;
-
-        Real drhoR = flux_coefR * flux(i,j,k,URHO);
-        Real rhoR = uR[URHO] + drhoR;
-
-        Real theta = 1.0_rt;
-
-        if (rhoL < density_floor) {
-
-            // Obtain the final density corresponding to the LF flux.
-
-            Real drhoLF = flux_coefL * fluxLF[URHO];
-            Real rhoLF = uL[URHO] - drhoLF;
-
-            // Solve for theta from (1 - theta) * rhoLF + theta * rho = density_floor.
-
-            theta = amrex::min(theta, (density_floor - rhoLF) / (rhoL - rhoLF));
-
-        }
-        else if (rhoR < density_floor) {
-
-            Real drhoLF = flux_coefR * fluxLF[URHO];
-            Real rhoLF = uR[URHO] + drhoLF;
-
-            theta = amrex::min(theta, (density_floor - rhoLF) / (rhoR - rhoLF));
-
-        }
-
-        // Limit theta to the valid range (this will deal with roundoff issues).
-
-        theta = amrex::min(1.0_rt, amrex::max(theta, 0.0_rt));
-
-        // Assemble the limited flux (Equation 16).
-
-        for (int n = 0; n < NUM_STATE; ++n) {
-            flux(i,j,k,n) = (1.0_rt - theta) * fluxLF[n] + theta * flux(i,j,k,n);
-        }
-
-        // Zero out fluxes for quantities that don't advect.
-
-        flux(i,j,k,UTEMP) = 0.0_rt;
-#ifdef SHOCK_VAR
-        flux(i,j,k,USHK) = 0.0_rt;
-#endif
-
-        // Now, apply our requirement that the final flux cannot violate the density floor.
-
-        drhoR = flux_coefR * flux(i,j,k,URHO);
-        drhoL = flux_coefL * flux(i,j,k,URHO);
-
-        if (uR[URHO] + drhoR < density_floor) {
-            for (int n = 0; n < NUM_STATE; ++n) {
-                flux(i,j,k,n) = flux(i,j,k,n) * std::abs((density_floor - uR[URHO]) / drhoR);
-            }
-        }
-        else if (uL[URHO] - drhoL < density_floor) {
-            for (int n = 0; n < NUM_STATE; ++n) {
-                flux(i,j,k,n) = flux(i,j,k,n) * std::abs((density_floor - uL[URHO]) / drhoL);
-            }
-        }
-
+        limit_face_flux_on_small_dens(i, j, k, idir, u, q, vol, flux, area_arr,
+                                      dt, dtdx, lcfl, alpha, density_floor,
+                                      coord, geomdata);
     });
 
 }
@@ -924,154 +769,82 @@ Castro::limit_hydro_fluxes_on_large_vel(const Box& bx,
     amrex::ParallelFor(bx,
     [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
     {
-        GpuArray<Real, NUM_STATE> uR;
-        for (int n = 0; n < NUM_STATE; ++n) {
-            uR[n] = u(i,j,k,n);
-        }
-
-        GpuArray<Real, NQ> qR;
-        for (int n = 0; n < NQ; ++n) {
-            qR[n] = q(i,j,k,n);
-        }
-
-        Real volR = vol(i,j,k);
-
-        GpuArray<int, 3> idxR = {i,j,k};
+        limit_face_flux_on_large_vel(i, j, k, idir, u, q, vol, flux, area_arr,
+                                     dt, dtdx, lcfl, alpha, lspeed_limit,
+                                     coord, geomdata);
+    });
 
-        GpuArray<Real, NUM_STATE> uL;
-        GpuArray<Real, NQ> qL;
-        Real volL;
-        GpuArray<int, 3> idxL;
+}
 
-        if (idir == 0) {
 
-            for (int n = 0; n < NUM_STATE; ++n) {
-                uL[n] = u(i-1,j,k,n);
-            }
 
-            for (int n = 0; n < NQ; ++n) {
-                qL[n] = q(i-1,j,k,n);
-            }
+void
+Castro::clean_hydro_fluxes(const Box& bx,
+                           const int idir,
+                           Array4<Real const> const& div,
+                           Array4<Real const> const& u,
+                           Array4<Real const> const& q,
+                           Array4<Real const> const& vol,
+                           Array4<Real> const& flux,
+                           Array4<Real const> const& area_arr,
+                           const Real dt)
+{
 
-            volL = vol(i-1,j,k);
+    // This does the same work, in the same order, as zeroing the
+    // temperature and shock fluxes and then calling apply_av,
+    // limit_hydro_fluxes_on_small_dens, limit_hydro_fluxes_on_large_vel,
+    // and normalize_species_fluxes, but in a single pass over the
+    // interfaces.  Each of those only modifies the flux through the
+    // interface it is working on, so the result is identical.
 
-            idxL = {i-1,j,k};
+    const Real* dx = geom.CellSize();
 
-        }
-        else if (idir == 1) {
+    const Real diff_coeff = difmag;
+    const Real dx_dir = dx[idir];
 
-            for (int n = 0; n < NUM_STATE; ++n) {
-                uL[n] = u(i,j-1,k,n);
-            }
+    // these match the setup in the individual limiters above
 
-            for (int n = 0; n < NQ; ++n) {
-                qL[n] = q(i,j-1,k,n);
-            }
+    const bool do_small_dens = limit_fluxes_on_small_dens == 1;
+    const bool do_large_vel = limit_fluxes_on_large_vel == 1 && castro::speed_limit > 0.0_rt;
 
-            volL = vol(i,j-1,k);
+    const Real density_floor_tolerance = 1.1_rt;
+    Real density_floor = small_dens * density_floor_tolerance;
+    density_floor *= AMREX_SPACEDIM * 2;
 
-            idxL = {i,j-1,k};
+    Real lspeed_limit = speed_limit / (2 * AMREX_SPACEDIM);
 
-        }
-        else {
+    Real dtdx = dt / dx[idir];
+    Real lcfl = cfl;
+    Real alpha = 1.0_rt / AMREX_SPACEDIM;
 
-            for (int n = 0; n < NUM_STATE; ++n) {
-                uL[n] = u(i,j,k-1,n);
-            }
+    auto coord = geom.Coord();
+    GeometryData geomdata = geom.data();
 
-            for (int n = 0; n < NQ; ++n) {
-                qL[n] = q(i,j,k-1,n);
-            }
+    amrex::ParallelFor(bx,
+    [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+    {
+        // the temperature and shock fluxes are physically meaningless
 
-            volL = vol(i,j,k-1);
+        flux(i,j,k,UTEMP) = 0.e0;
+#ifdef SHOCK_VAR
+        flux(i,j,k,USHK) = 0.e0;
+#endif
 
-            idxL = {i,j,k-1};
+        apply_av_face(i, j, k, idir, div, u, flux, diff_coeff, dx_dir);
 
+        if (do_small_dens) {
+            limit_face_flux_on_small_dens(i, j, k, idir, u, q, vol, flux, area_arr,
+                                          dt, dtdx, lcfl, alpha, density_floor,
+                                          coord, geomdata);
         }
 
-        // Construct cell-centered fluxes.
-
-         GpuArray<Real, NUM_STATE> fluxL;
-         dflux(uL, qL, idir, coord, geomdata, idxL, fluxL);
-
-         GpuArray<Real, NUM_STATE> fluxR;
-         dflux(uR, qR, idir, coord, geomdata, idxR, fluxR);
-
-         // Construct the Lax-Friedrichs flux on the interface.
-
-         GpuArray<Real, NUM_STATE> fluxLF;
-         for (int n = 0; n < NUM_STATE; ++n) {
-             fluxLF[n] = 0.5_rt * (fluxL[n] + fluxR[n] + (lcfl / dtdx / alpha) * (uL[n] - uR[n]));
-         }
-
-         // Coefficients of fluxes on either side of the interface.
-
-         Real flux_coefR = 2.0_rt * (dt / alpha) * area_arr(i,j,k) / volR;
-         Real flux_coefL = 2.0_rt * (dt / alpha) * area_arr(i,j,k) / volL;
-
-         Real theta = 1.0_rt;
-
-         // Loop over all three momenta, and choose the strictest
-         // limiter among them.
-
-         for (int n = 0; n < 3; ++n) {
-
-             int UMOM = UMX + n;
-
-             // Obtain the one-sided update to the momentum.
-
-             Real drhouL = flux_coefL * flux(i,j,k,UMOM);
-             Real rhouL = std::abs(uL[UMOM] - drhouL);
-
-             Real drhoL = flux_coefL * flux(i,j,k,URHO);
-             Real rhoL = uL[URHO] - drhoL;
-
-             Real drhouR = flux_coefR * flux(i,j,k,UMOM);
-             Real rhouR = std::abs(uR[UMOM] + drhouR);
-
-             Real drhoR = flux_coefR * flux(i,j,k,URHO);
-             Real rhoR = uR[URHO] + drhoR;
-
-             if (std::abs(rhouL) > rhoL * lspeed_limit) {
-
-                 // Obtain the final density corresponding to the LF flux.
-
-                 Real drhouLF = flux_coefL * fluxLF[UMOM];
-                 Real rhouLF = std::abs(uL[UMOM] - drhouLF);
-
-                 // Solve for theta from (1 - theta) * rhouLF + theta * rhou = rhoL * speed_limit.
-
-                 theta = amrex::min(theta, std::abs(rhoL * lspeed_limit - rhouLF) / std::abs(rhouL - rhouLF));
-
-             }
-             else if (std::abs(rhouR) > rhoR * lspeed_limit) {
-
-                 Real drhouLF = flux_coefR * fluxLF[UMOM];
-                 Real rhouLF = std::abs(uR[UMOM] + drhouLF);
-
-                 theta = amrex::min(theta, std::abs(rhoR * lspeed_limit - rhouLF) / std::abs(rhouR - rhouLF));
-
-             }
-
-         }
-
-         // Limit theta to the valid range (this will deal with roundoff issues).
-
-         theta = amrex::min(1.0_rt, amrex::max(theta, 0.0_rt));
-
-         // Assemble the limited flux (Equation 16).
-
-         for (int n = 0; n < NUM_STATE; ++n) {
-             flux(i,j,k,n) = (1.0_rt - theta) * fluxLF[n] + theta * flux(i,j,k,n);
-         }
-
-         // Zero out fluxes for quantities that don't advect.
-
-         flux(i,j,k,UTEMP) = 0.0_rt;
-#ifdef SHOCK_VAR
-         flux(i,j,k,USHK) = 0.0_rt;
-#endif
+        if (do_large_vel) {
+            limit_face_flux_on_large_vel(i, j, k, idir, u, q, vol, flux, area_arr,
+                                         dt, dtdx, lcfl, alpha, lspeed_limit,
+                                         coord, geomdata);
+        }
 
+        normalize_species_face_flux(i, j, k, flux);
     });
 
 }
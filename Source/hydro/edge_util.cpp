@@ -1,11 +1,12 @@
 #include <Castro.H>
 #include <Castro_hydro.H>
+#include <edge_util.H>
 
 using namespace amrex;
 
 void
 Castro::reset_edge_state_thermo(const Box& bx,
-                                Array4<Real> const& qedge)
+                                Array4<qedge_t> const& qedge)
 {
 
     int use_eos = transverse_use_eos;
@@ -17,60 +18,7 @@ Castro::reset_edge_state_thermo(const Box& bx,
     amrex::ParallelFor(bx,
     [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
     {
-
-#ifdef RADIATION
-        Real old_p_state = qedge(i,j,k,QPRES);
-#endif
-
-        eos_rep_t eos_state;
-
-        if (reset_rhoe == 1) {
-            // if we are still negative, then we need to reset
-            if (qedge(i,j,k,QREINT) < 0.0_rt) {
-
-                eos_state.rho = qedge(i,j,k,QRHO);
-                eos_state.T = small_t;
-                for (int n = 0; n < NumSpec; ++n) {
-                    eos_state.xn[n] = qedge(i,j,k,QFS+n);
-                }
-#if NAUX_NET > 0
-                for (int n = 0; n < NumAux; ++n) {
-                    eos_state.aux[n] = qedge(i,j,k,QFX+n);
-                }
-#endif
-
-                eos(eos_input_rt, eos_state);
-
-                qedge(i,j,k,QREINT) = qedge(i,j,k,QRHO) * eos_state.e;
-                qedge(i,j,k,QPRES) = eos_state.p;
-            }
-        }
-
-        if (use_eos == 1) {
-            eos_state.rho = qedge(i,j,k,QRHO);
-            eos_state.e   = qedge(i,j,k,QREINT) / qedge(i,j,k,QRHO);
-            eos_state.T   = small_t;
-            for (int n = 0; n < NumSpec; ++n) {
-                eos_state.xn[n] = qedge(i,j,k,QFS+n);
-            }
-#if NAUX_NET > 0
-            for (int n = 0; n < NumAux; ++n) {
-                eos_state.aux[n] = qedge(i,j,k,QFX+n);
-            }
-#endif
-
-            eos(eos_input_re, eos_state);
-
-            qedge(i,j,k,QREINT) = eos_state.e * eos_state.rho;
-            qedge(i,j,k,QPRES) = amrex::max(eos_state.p, small_p);
-        }
-
-#ifdef RADIATION
-        // correct the total pressure (gas + radiation) with any
-        // change to the gas pressure state
-        qedge(i,j,k,QPTOT) = qedge(i,j,k,QPTOT) + (qedge(i,j,k,QPRES) - old_p_state);
-#endif
-
+        reset_edge_state_thermo_zone(i, j, k, qedge, use_eos, reset_rhoe, small_t, small_p);
     });
 
 }
@@ -79,8 +27,8 @@ Castro::reset_edge_state_thermo(const Box& bx,
 
 void
 Castro::edge_state_temp_to_pres(const Box& bx,
-                                Array4<Real> const& qm,
-                                Array4<Real> const& qp)
+                                Array4<qedge_t> const& qm,
+                                Array4<qedge_t> const& qp)
 {
 
     // use T to define p
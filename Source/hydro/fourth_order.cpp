@@ -227,8 +227,8 @@ Castro::states(const Box& bx,
                Array4<Real const> const& a,
                Array4<Real const> const& a_int,
                Array4<Real const> const& flatn,
-               Array4<Real> const& al,
-               Array4<Real> const& ar) {
+               Array4<qedge_t> const& al,
+               Array4<qedge_t> const& ar) {
 
   // our convention here is that:
   //     al(i,j,k)   will be al_{i-1/2,j,k),
@@ -2,6 +2,7 @@
 #include <Castro_F.H>
 
 #include <riemann_solvers.H>
+#include <riemann_batched.H>
 
 #ifdef RADIATION
 #include <Radiation.H>
@@ -14,8 +15,8 @@ using namespace amrex;
 
 void
 Castro::cmpflx_plus_godunov(const Box& bx,
-                            Array4<Real> const& qm,
-                            Array4<Real> const& qp,
+                            Array4<qedge_t> const& qm,
+                            Array4<qedge_t> const& qp,
                             Array4<Real> const& flx,
 #ifdef RADIATION
                             Array4<Real> const& rflx,
@@ -48,6 +49,22 @@ Castro::cmpflx_plus_godunov(const Box& bx,
     }
 #endif
 
+    // with riemann_cg_shocks_only, we only use the CG solver on the
+    // interfaces adjacent to a shock and the CGF solver elsewhere
+
+    const bool cg_shocks_only = riemann_solver == 1 && riemann_cg_shocks_only == 1;
+
+#if !defined(AMREX_USE_GPU) && !defined(RADIATION)
+    // on CPUs we can optionally do the Riemann solves in batches
+    // along pencils to allow for vectorization
+
+    if (riemann_batched == 1 && riemann_solver != 2 && ppm_temp_fix != 2) {
+        cmpflx_plus_godunov_batched(bx, qm, qp, flx, qgdnv,
+                                    qaux_arr, shk, idir, store_full_state);
+        return;
+    }
+#endif
+
     const int* lo_bc = phys_bc.lo();
     const int* hi_bc = phys_bc.hi();
 
@@ -83,6 +100,11 @@ Castro::cmpflx_plus_godunov(const Box& bx,
 
             // first find the interface state on the current interface
 
+            int solver = riemann_solver;
+            if (cg_shocks_only && !interface_is_shock(i, j, k, idir, shk)) {
+                solver = 0;
+            }
+
             RiemannState qint;
 
             riemann_state(i, j, k, idir,
@@ -90,7 +112,8 @@ Castro::cmpflx_plus_godunov(const Box& bx,
                           qint,
                           geomdata,
                           special_bnd_lo, special_bnd_hi,
-                          domlo, domhi);
+                          domlo, domhi,
+                          solver);
 
             // now use the interface state to compute and store the flux
 
@@ -106,29 +129,9 @@ Castro::cmpflx_plus_godunov(const Box& bx,
 
             // now do the passives -- we didn't include them in qint, qgdnv, or flux above
 
-            // the passives are always just upwinded, so we do that here
-            // regardless of the solver
-
-            Real sgnm = std::copysign(1.0_rt, qint.un);
-            if (qint.un == 0.0_rt) {
-                sgnm = 0.0_rt;
-            }
-
-            Real fp = 0.5_rt*(1.0_rt + sgnm);
-            Real fm = 0.5_rt*(1.0_rt - sgnm);
-
-            for (int ipassive = 0; ipassive < npassive; ipassive++) {
-                int nqp = qpassmap(ipassive);
-                int n  = upassmap(ipassive);
-
-                Real X_int = fp * qm(i,j,k,nqp) + fm * qp(i,j,k,nqp);
-
-                flx(i,j,k,n) = flx(i,j,k,URHO) * X_int;
-
-                if (store_full_state) {
-                    qgdnv(i,j,k,nqp) = X_int;
-                }
-            }
+            upwind_passives(i, j, k, qint.un,
+                            qm, qp, flx,
+                            qgdnv, store_full_state);
 
         } else if (riemann_solver == 2) {
             // HLLC
@@ -151,58 +154,222 @@ Castro::cmpflx_plus_godunov(const Box& bx,
             // correct the fluxes using an HLL scheme if we are in a shock
             // and doing the hybrid approach
 
-            int is_shock = 0;
+            hybrid_hll_correction(i, j, k, idir, coord,
+                                  qm, qp, qaux_arr, shk,
+                                  flx);
+        }
+    });
 
-            if (idir == 0) {
-                is_shock = static_cast<int>(shk(i-1,j,k) + shk(i,j,k));
-            } else if (idir == 1) { 
-                is_shock = static_cast<int>(shk(i,j-1,k) + shk(i,j,k));
-            } else {
-                is_shock = static_cast<int>(shk(i,j,k-1) + shk(i,j,k));
-            }
+}
 
-            if (is_shock >= 1) {
 
-                Real cl;
-                Real cr;
-                if (idir == 0) {
-                    cl = qaux_arr(i-1,j,k,QC);
-                    cr = qaux_arr(i,j,k,QC);
-                } else if (idir == 1) { 
-                    cl = qaux_arr(i,j-1,k,QC);
-                    cr = qaux_arr(i,j,k,QC);
-                } else {
-                    cl = qaux_arr(i,j,k-1,QC);
-                    cr = qaux_arr(i,j,k,QC);
-                }
 
-                Real ql_zone[NQ];
-                Real qr_zone[NQ];
-                Real flx_zone[NUM_STATE];
 
-                for (int n = 0; n < NQ; n++) {
-                    ql_zone[n] = qm(i,j,k,n);
-                    qr_zone[n] = qp(i,j,k,n);
+#if !defined(AMREX_USE_GPU) && !defined(RADIATION)
+void
+Castro::cmpflx_plus_godunov_batched(const Box& bx,
+                                    Array4<qedge_t> const& qm,
+                                    Array4<qedge_t> const& qp,
+                                    Array4<Real> const& flx,
+                                    Array4<Real> const& qgdnv,
+                                    Array4<Real const> const& qaux_arr,
+                                    Array4<Real const> const& shk,
+                                    const int idir, const bool store_full_state) {
+
+    // this is the same as cmpflx_plus_godunov, but instead of doing
+    // one interface at a time, we gather RIEMANN_BATCH_SIZE
+    // interfaces along an i-pencil into structure-of-arrays storage
+    // and solve them together.  The CGF solver is done entirely in
+    // SIMD lanes.  Any lane that needs an EOS call to reset its
+    // thermodynamics, and every lane for the Colella & Glaz solver
+    // (since it requires the secant iteration), is instead done with
+    // the scalar solver.  With riemann_cg_shocks_only, only the lanes
+    // at shocks need the CG iteration.
+
+    const int* lo_bc = phys_bc.lo();
+    const int* hi_bc = phys_bc.hi();
+
+    // do we want to force the flux to zero at the boundary?
+    const bool special_bnd_lo = (lo_bc[idir] == Symmetry ||
+                                 lo_bc[idir] == SlipWall ||
+                                 lo_bc[idir] == NoSlipWall);
+    const bool special_bnd_hi = (hi_bc[idir] == Symmetry ||
+                                 hi_bc[idir] == SlipWall ||
+                                 hi_bc[idir] == NoSlipWall);
+
+    auto coord = geom.Coord();
+
+    GeometryData geomdata = geom.data();
+
+    const auto domlo = geom.Domain().loVect3d();
+    const auto domhi = geom.Domain().hiVect3d();
+
+    const bool cg_shocks_only = riemann_solver == 1 && riemann_cg_shocks_only == 1;
+
+    const auto lo = amrex::lbound(bx);
+    const auto hi = amrex::ubound(bx);
+
+    RiemannBatch rb;
+
+    for (int k = lo.z; k <= hi.z; ++k) {
+        for (int j = lo.y; j <= hi.y; ++j) {
+            for (int i0 = lo.x; i0 <= hi.x; i0 += RIEMANN_BATCH_SIZE) {
+
+                const int nlanes = amrex::min(RIEMANN_BATCH_SIZE, hi.x - i0 + 1);
+
+                load_input_states_batch(i0, nlanes, j, k, idir,
+                                        qm, qp, qaux_arr, rb);
+
+                // deal with hard walls
+
+                for (int n = 0; n < nlanes; ++n) {
+                    const int idx = idir == 0 ? i0 + n : (idir == 1 ? j : k);
+                    rb.bnd_fac[n] = ((idx == domlo[idir] && special_bnd_lo) ||
+                                     (idx == domhi[idir]+1 && special_bnd_hi)) ? 0.0_rt : 1.0_rt;
                 }
 
-                // pass in the current flux -- the
-                // HLL solver will overwrite this
-                // if necessary
-                for (int n = 0; n < NUM_STATE; n++) {
-                    flx_zone[n] = flx(i,j,k,n);
+                if (riemann_solver == 0) {
+                    riemannus_batch(nlanes, rb);
+                } else if (cg_shocks_only) {
+                    // only the interfaces at shocks need the CG iteration
+                    riemannus_batch(nlanes, rb);
+                    for (int n = 0; n < nlanes; ++n) {
+                        if (interface_is_shock(i0 + n, j, k, idir, shk)) {
+                            rb.scalar[n] = 1;
+                        }
+                    }
+                } else {
+                    for (int n = 0; n < nlanes; ++n) {
+                        rb.scalar[n] = 1;
+                    }
                 }
 
-                HLL(ql_zone, qr_zone, cl, cr,
-                    idir, coord,
-                    flx_zone);
+                // redo any lanes that need the full scalar solver
+
+                for (int n = 0; n < nlanes; ++n) {
+                    if (rb.scalar[n] == 1) {
+                        int solver = riemann_solver;
+                        if (cg_shocks_only && !interface_is_shock(i0 + n, j, k, idir, shk)) {
+                            solver = 0;
+                        }
+
+                        RiemannState qint;
+
+                        riemann_state(i0 + n, j, k, idir,
+                                      qm, qp, qaux_arr,
+                                      qint,
+                                      geomdata,
+                                      special_bnd_lo, special_bnd_hi,
+                                      domlo, domhi,
+                                      solver);
+
+                        rb.rho[n] = qint.rho;
+                        rb.un[n] = qint.un;
+                        rb.ut[n] = qint.ut;
+                        rb.utt[n] = qint.utt;
+                        rb.p[n] = qint.p;
+                        rb.rhoe[n] = qint.rhoe;
+                    }
+                }
 
-                for (int n = 0; n < NUM_STATE; n++) {
-                    flx(i,j,k,n) = flx_zone[n];
+                // scatter the interface state and compute the fluxes
+
+                for (int n = 0; n < nlanes; ++n) {
+                    const int i = i0 + n;
+
+                    RiemannState qint;
+                    qint.rho = rb.rho[n];
+                    qint.un = rb.un[n];
+                    qint.ut = rb.ut[n];
+                    qint.utt = rb.utt[n];
+                    qint.p = rb.p[n];
+                    qint.rhoe = rb.rhoe[n];
+
+                    compute_flux_q(i, j, k, idir,
+                                   geomdata,
+                                   qint, flx,
+                                   qgdnv, store_full_state);
+
+                    upwind_passives(i, j, k, qint.un,
+                                    qm, qp, flx,
+                                    qgdnv, store_full_state);
+
+                    if (hybrid_riemann == 1) {
+                        hybrid_hll_correction(i, j, k, idir, coord,
+                                              qm, qp, qaux_arr, shk,
+                                              flx);
+                    }
                 }
             }
         }
+    }
+
+}
+#endif
+
+
+
+void
+Castro::count_riemann_dispatch(const Box& bx, const int idir,
+                               Array4<Real const> const& shk) {
+
+    // count the interfaces in bx that will use the full CG solver
+    // (those adjacent to a shock) and the total number of interfaces
+
+    ReduceOps<ReduceOpSum> reduce_op;
+    ReduceData<Long> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+
+    reduce_op.eval(bx, reduce_data,
+    [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> ReduceTuple
+    {
+        return {interface_is_shock(i, j, k, idir, shk) ? 1 : 0};
     });
 
+    ReduceTuple hv = reduce_data.value();
+    Long ncg = amrex::get<0>(hv);
+    Long ntot = bx.numPts();
+
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+    num_riemann_cg += ncg;
+
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+    num_riemann_cgf += ntot - ncg;
+
 }
 
 
+
+void
+Castro::report_riemann_dispatch() {
+
+    // report the fraction of interfaces that used the full CG solver
+    // vs. the two-shock CGF approximation and reset the counters
+
+    Long ncg = num_riemann_cg;
+    Long ncgf = num_riemann_cgf;
+
+    num_riemann_cg = 0;
+    num_riemann_cgf = 0;
+
+#ifdef BL_LAZY
+    Lazy::QueueReduction( [=] () mutable {
+#endif
+        ParallelDescriptor::ReduceLongSum(ncg, ParallelDescriptor::IOProcessorNumber());
+        ParallelDescriptor::ReduceLongSum(ncgf, ParallelDescriptor::IOProcessorNumber());
+
+        if (ParallelDescriptor::IOProcessor()) {
+            Real ntot = static_cast<Real>(amrex::max(ncg + ncgf, static_cast<Long>(1)));
+            std::cout << "... Riemann solves on level " << level << ": "
+                      << 100.0_rt * static_cast<Real>(ncg) / ntot << "% CG (shocks), "
+                      << 100.0_rt * static_cast<Real>(ncgf) / ntot << "% CGF (smooth)" << std::endl;
+        }
+#ifdef BL_LAZY
+    });
+#endif
+
+}
@@ -18,8 +18,8 @@ Castro::trace_plm(const Box& bx, const int idir,
                   Array4<Real const> const& q_arr,
                   Array4<Real const> const& qaux_arr,
                   Array4<Real const> const& flatn_arr,
-                  Array4<Real> const& qm,
-                  Array4<Real> const& qp,
+                  Array4<qedge_t> const& qm,
+                  Array4<qedge_t> const& qp,
 #if AMREX_SPACEDIM < 3
                   Array4<Real const> const& dloga,
 #endif
@@ -195,7 +195,7 @@ Castro::trace_plm(const Box& bx, const int idir,
 
       // add the source terms
       qp(i,j,k,QRHO  ) += 0.5_rt*dt*srcQ(i,j,k,QRHO);
-      qp(i,j,k,QRHO  ) = amrex::max(lsmall_dens, qp(i,j,k,QRHO));
+      qp(i,j,k,QRHO  ) = amrex::max<Real>(lsmall_dens, qp(i,j,k,QRHO));
       qp(i,j,k,QUN   ) += 0.5_rt*dt*srcQ(i,j,k,QUN);
       qp(i,j,k,QUT   ) += 0.5_rt*dt*srcQ(i,j,k,QUT);
       qp(i,j,k,QUTT  ) += 0.5_rt*dt*srcQ(i,j,k,QUTT);
@@ -288,14 +288,14 @@ Castro::trace_plm(const Box& bx, const int idir,
 
       if (i <= vhi[0]) {
         qm(i+1,j,k,QRHO) += sourcr;
-        qm(i+1,j,k,QRHO) = amrex::max(qm(i+1,j,k,QRHO), lsmall_dens);
+        qm(i+1,j,k,QRHO) = amrex::max<Real>(qm(i+1,j,k,QRHO), lsmall_dens);
         qm(i+1,j,k,QPRES) += sourcp;
         qm(i+1,j,k,QREINT) += source;
       }
 
       if (i >= vlo[0]) {
         qp(i,j,k,QRHO) += sourcr;
-        qp(i,j,k,QRHO) = amrex::max(qp(i,j,k,QRHO), lsmall_dens);
+        qp(i,j,k,QRHO) = amrex::max<Real>(qp(i,j,k,QRHO), lsmall_dens);
         qp(i,j,k,QPRES) += sourcp;
         qp(i,j,k,QREINT) += source;
       }
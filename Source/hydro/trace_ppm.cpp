@@ -19,8 +19,8 @@ Castro::trace_ppm(const Box& bx,
                   Array4<Real const> const& qaux_arr,
                   Array4<Real const> const& srcQ,
                   Array4<Real const> const& flatn,
-                  Array4<Real> const& qm,
-                  Array4<Real> const& qp,
+                  Array4<qedge_t> const& qm,
+                  Array4<qedge_t> const& qp,
 #if (AMREX_SPACEDIM < 3)
                   Array4<Real const> const& dloga,
 #endif
@@ -566,14 +566,14 @@ Castro::trace_ppm(const Box& bx,
 
       if (i <= vhi[0]) {
         qm(i+1,j,k,QRHO) = qm(i+1,j,k,QRHO) + sourcr;
-        qm(i+1,j,k,QRHO) = amrex::max(qm(i+1,j,k,QRHO), lsmall_dens);
+        qm(i+1,j,k,QRHO) = amrex::max<Real>(qm(i+1,j,k,QRHO), lsmall_dens);
         qm(i+1,j,k,QPRES) = qm(i+1,j,k,QPRES) + sourcp;
         qm(i+1,j,k,QREINT) = qm(i+1,j,k,QREINT) + source;
       }
 
       if (i >= vlo[0]) {
         qp(i,j,k,QRHO) = qp(i,j,k,QRHO) + sourcr;
-        qp(i,j,k,QRHO) = amrex::max(qp(i,j,k,QRHO), lsmall_dens);
+        qp(i,j,k,QRHO) = amrex::max<Real>(qp(i,j,k,QRHO), lsmall_dens);
         qp(i,j,k,QPRES) = qp(i,j,k,QPRES) + sourcp;
         qp(i,j,k,QREINT) = qp(i,j,k,QREINT) + source;
       }
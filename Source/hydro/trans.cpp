@@ -1,5 +1,6 @@
 #include <Castro.H>
 #include <Castro_util.H>
+#include <edge_util.H>
 
 #ifdef RADIATION
 #include <Radiation.H>
@@ -14,10 +15,10 @@ using namespace amrex;
 void
 Castro::trans_single(const Box& bx,
                      int idir_t, int idir_n,
-                     Array4<Real const> const& qm,
-                     Array4<Real> const& qmo,
-                     Array4<Real const> const& qp,
-                     Array4<Real> const& qpo,
+                     Array4<qedge_t const> const& qm,
+                     Array4<qedge_t> const& qmo,
+                     Array4<qedge_t const> const& qp,
+                     Array4<qedge_t> const& qpo,
                      Array4<Real const> const& qaux_arr,
                      Array4<Real const> const& flux_t,
 #ifdef RADIATION
@@ -63,11 +64,380 @@ Castro::trans_single(const Box& bx,
 }
 
 
+namespace {
+
+// everything that the first-order transverse update of an interface
+// state needs from the transverse flux through one zone.  The plus
+// state of an interface and the minus state of the next interface (in
+// the normal direction) both sit in the same zone, as do the states in
+// each of the normal directions, so this can be shared among them.
+
+struct trans_zone_t
+{
+    // the transverse flux difference of each conserved quantity
+    // (including the area factors in 2-d)
+    GpuArray<Real, NUM_STATE> dF;
+
+    Real pgp, pgm;
+    Real ugp, ugm;
+    Real dup, du, pav;
+
+    // this is the gas gamma_1
+    Real gamc;
+
+#if AMREX_SPACEDIM == 2
+    Real volinv;
+#endif
+
+#ifdef RADIATION
+    Real lambda[NGROUPS];
+    Real drF[NGROUPS];
+    Real der[NGROUPS];
+    Real dmom;
+    Real dre;
+#if AMREX_SPACEDIM == 2
+    Real lamge_sum;
+    Real area_sum;
+#endif
+#endif
+};
+
+
+// load the transverse flux difference through the zone (il, jl, kl),
+// whose upper face in the transverse direction is (ir, jr, kr)
+
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+void
+load_trans_zone(const int il, const int jl, const int kl,
+                const int ir, const int jr, const int kr,
+                const int idir_t,
+                Array4<Real const> const& qaux_arr,
+                Array4<Real const> const& flux_t,
+#ifdef RADIATION
+                Array4<Real const> const& rflux_t,
+#endif
+                Array4<Real const> const& q_t,
+#if AMREX_SPACEDIM == 2
+                Array4<Real const> const& area_t,
+                Array4<Real const> const& vol,
+#endif
+#ifdef RADIATION
+                const int fspace_t, const int comov,
+                const int limiter, const int closure,
+#endif
+                const Real hdt, const Real cdtdx,
+                trans_zone_t& tz)
+{
+    amrex::ignore_unused(hdt, cdtdx);
+
+#if AMREX_SPACEDIM == 2
+    tz.volinv = 1.0_rt / vol(il,jl,kl);
+
+    for (int n = 0; n < NUM_STATE; ++n) {
+        tz.dF[n] = area_t(ir,jr,kr) * flux_t(ir,jr,kr,n) -
+                   area_t(il,jl,kl) * flux_t(il,jl,kl,n);
+    }
+#else
+    for (int n = 0; n < NUM_STATE; ++n) {
+        tz.dF[n] = flux_t(ir,jr,kr,n) - flux_t(il,jl,kl,n);
+    }
+#endif
+
+    tz.pgp = q_t(ir,jr,kr,GDPRES);
+    tz.pgm = q_t(il,jl,kl,GDPRES);
+    tz.ugp = q_t(ir,jr,kr,GDU+idir_t);
+    tz.ugm = q_t(il,jl,kl,GDU+idir_t);
+
+#ifdef RADIATION
+    Real ergp[NGROUPS];
+    Real ergm[NGROUPS];
+
+    for (int g = 0; g < NGROUPS; ++g) {
+        tz.lambda[g] = qaux_arr(il,jl,kl,QLAMS+g);
+        ergp[g] = q_t(ir,jr,kr,GDERADS+g);
+        ergm[g] = q_t(il,jl,kl,GDERADS+g);
+    }
+#endif
+
+    // we need to augment our conserved system with either a p
+    // equation or gammae (if we have ppm_predict_gammae = 1) to
+    // be able to deal with the general EOS
+
+#if AMREX_SPACEDIM == 2
+    tz.dup = area_t(ir,jr,kr) * tz.pgp * tz.ugp - area_t(il,jl,kl) * tz.pgm * tz.ugm;
+    tz.du = area_t(ir,jr,kr) * tz.ugp - area_t(il,jl,kl) * tz.ugm;
+#else
+    tz.dup = tz.pgp * tz.ugp - tz.pgm * tz.ugm;
+    tz.du = tz.ugp - tz.ugm;
+#endif
+    tz.pav = 0.5_rt * (tz.pgp + tz.pgm);
+
+#ifdef RADIATION
+    tz.gamc = qaux_arr(il,jl,kl,QGAMCG);
+#else
+    tz.gamc = qaux_arr(il,jl,kl,QGAMC);
+#endif
+
+#ifdef RADIATION
+    Real uav = 0.5_rt * (tz.ugp + tz.ugm);
+
+    Real lamge[NGROUPS];
+    Real luge[NGROUPS];
+
+    tz.dmom = 0.0_rt;
+    tz.dre = 0.0_rt;
+
+    for (int g = 0; g < NGROUPS; ++g) {
+        lamge[g] = tz.lambda[g] * (ergp[g] - ergm[g]);
+        tz.dmom += -cdtdx * lamge[g];
+        luge[g] = uav * lamge[g];
+        tz.dre += -cdtdx * luge[g];
+    }
+
+    if (fspace_t == 1 && comov) {
+        for (int g = 0; g < NGROUPS; ++g) {
+            Real eddf = Edd_factor(tz.lambda[g], limiter, closure);
+            Real f1 = 0.5_rt * (1.0_rt - eddf);
+            tz.der[g] = cdtdx * uav * f1 * (ergp[g] - ergm[g]);
+        }
+    }
+    else if (fspace_t == 2) {
+#if AMREX_SPACEDIM == 2
+        Real divu = (area_t(ir,jr,kr) * tz.ugp - area_t(il,jl,kl) * tz.ugm) * tz.volinv;
+        for (int g = 0; g < NGROUPS; g++) {
+            Real eddf = Edd_factor(tz.lambda[g], limiter, closure);
+            Real f1 = 0.5_rt * (1.0_rt - eddf);
+            tz.der[g] = -hdt * f1 * 0.5_rt * (ergp[g] + ergm[g]) * divu;
+        }
+#else
+        for (int g = 0; g < NGROUPS; g++) {
+            Real eddf = Edd_factor(tz.lambda[g], limiter, closure);
+            Real f1 = 0.5_rt * (1.0_rt - eddf);
+            tz.der[g] = cdtdx * f1 * 0.5_rt * (ergp[g] + ergm[g]) * (tz.ugm - tz.ugp);
+        }
+#endif
+    }
+    else { // mixed frame
+        for (int g = 0; g < NGROUPS; g++) {
+            tz.der[g] = cdtdx * luge[g];
+        }
+    }
+
+#if AMREX_SPACEDIM == 2
+    tz.lamge_sum = 0.0_rt;
+    for (int g = 0; g < NGROUPS; ++g) {
+        tz.lamge_sum = tz.lamge_sum + lamge[g];
+    }
+
+    tz.area_sum = area_t(ir,jr,kr) + area_t(il,jl,kl);
+
+    for (int g = 0; g < NGROUPS; ++g) {
+        tz.drF[g] = area_t(ir,jr,kr) * rflux_t(ir,jr,kr,g) -
+                    area_t(il,jl,kl) * rflux_t(il,jl,kl,g);
+    }
+#else
+    for (int g = 0; g < NGROUPS; ++g) {
+        tz.drF[g] = rflux_t(ir,jr,kr,g) - rflux_t(il,jl,kl,g);
+    }
+#endif
+#endif
+}
+
+
+// add the transverse flux difference through a zone, tz, to the
+// interface state q_arr(i,j,k) that sits in that zone
+
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+void
+apply_trans_zone(const int i, const int j, const int k,
+                 const int idir_t,
+                 const trans_zone_t& tz,
+                 Array4<qedge_t const> const& q_arr,
+                 Array4<qedge_t> const& qo_arr,
+                 const Real hdt, const Real cdtdx, const int coord,
+                 const bool reset_density, const bool reset_rhoe,
+                 const Real small_p)
+{
+    amrex::ignore_unused(hdt, coord, idir_t);
+
+    // Update all of the passively-advected quantities with the
+    // transverse term and convert back to the primitive quantity.
+
+    for (int ipassive = 0; ipassive < npassive; ipassive++) {
+        int n = upassmap(ipassive);
+        int nqp = qpassmap(ipassive);
+
+#if AMREX_SPACEDIM == 2
+        Real rrnew = q_arr(i,j,k,QRHO) - hdt * tz.dF[URHO] * tz.volinv;
+        Real compu = q_arr(i,j,k,QRHO) * q_arr(i,j,k,nqp) - hdt * tz.dF[n] * tz.volinv;
+        qo_arr(i,j,k,nqp) = compu / rrnew;
+#else
+        Real rrnew = q_arr(i,j,k,QRHO) - cdtdx * tz.dF[URHO];
+        Real compu = q_arr(i,j,k,QRHO) * q_arr(i,j,k,nqp) - cdtdx * tz.dF[n];
+        qo_arr(i,j,k,nqp) = compu / rrnew;
+#endif
+    }
+
+    // Convert to conservation form
+    Real rrn = q_arr(i,j,k,QRHO);
+    Real run = rrn * q_arr(i,j,k,QU);
+    Real rvn = rrn * q_arr(i,j,k,QV);
+    Real rwn = rrn * q_arr(i,j,k,QW);
+    Real ekenn = 0.5_rt * rrn * (q_arr(i,j,k,QU) * q_arr(i,j,k,QU) + q_arr(i,j,k,QV) * q_arr(i,j,k,QV) + q_arr(i,j,k,QW) * q_arr(i,j,k,QW));
+    Real ren = q_arr(i,j,k,QREINT) + ekenn;
+#ifdef RADIATION
+    Real ern[NGROUPS];
+    for (int g = 0; g < NGROUPS; ++g) {
+        ern[g] = q_arr(i,j,k,QRAD+g);
+    }
+#endif
+
+#if AMREX_SPACEDIM == 2
+    // Add transverse predictor
+    Real rrnewn = rrn - hdt * tz.dF[URHO] * tz.volinv;
+
+    // Note that pressure may be treated specially here, depending on
+    // the geometry.  Our y-interface equation for (rho u) is:
+    //
+    //  d(rho u)/dt + d(rho u v)/dy = - 1/r d(r rho u u)/dr - dp/dr
+    //
+    // in cylindrical coords -- note that the p term is not
+    // in a divergence for UMX in the x-direction, so there
+    // are no area factors.  For this geometry, we do not
+    // include p in our definition of the flux in the
+    // x-direction, for we need to fix this now.
+    Real runewn = run - hdt * tz.dF[UMX] * tz.volinv;
+    if (idir_t == 0 && !mom_flux_has_p(0, idir_t, coord)) {
+        runewn = runewn - cdtdx * (tz.pgp - tz.pgm);
+    }
+    Real rvnewn = rvn - hdt * tz.dF[UMY] * tz.volinv;
+    Real rwnewn = rwn - hdt * tz.dF[UMZ] * tz.volinv;
+    Real renewn = ren - hdt * tz.dF[UEDEN] * tz.volinv;
+
+#ifdef RADIATION
+    if (idir_t == 0) {
+        runewn = runewn - 0.5_rt * hdt * tz.area_sum * tz.lamge_sum * tz.volinv;
+    }
+    else {
+        rvnewn = rvnewn + tz.dmom;
+    }
+
+    renewn = renewn + tz.dre;
+
+    Real ernewn[NGROUPS];
+    for (int g = 0; g < NGROUPS; ++g) {
+        ernewn[g] = ern[g] - hdt * tz.drF[g] * tz.volinv + tz.der[g];
+    }
+#endif
+
+#else
+    // Add transverse predictor
+    Real rrnewn = rrn - cdtdx * tz.dF[URHO];
+    Real runewn = run - cdtdx * tz.dF[UMX];
+    Real rvnewn = rvn - cdtdx * tz.dF[UMY];
+    Real rwnewn = rwn - cdtdx * tz.dF[UMZ];
+    Real renewn = ren - cdtdx * tz.dF[UEDEN];
+#ifdef RADIATION
+    runewn = runewn + tz.dmom;
+    renewn = renewn + tz.dre;
+    Real ernewn[NGROUPS];
+    for (int g = 0; g < NGROUPS; ++g) {
+        ernewn[g] = ern[g] - cdtdx * tz.drF[g] + tz.der[g];
+    }
+#endif
+#endif
+
+    // Reset to original value if adding transverse terms made density negative
+    bool reset_state = false;
+    if (reset_density == 1 && rrnewn < 0.0_rt) {
+        rrnewn = rrn;
+        runewn = run;
+        rvnewn = rvn;
+        rwnewn = rwn;
+        renewn = ren;
+#ifdef RADIATION
+        for (int g = 0; g < NGROUPS; ++g) {
+            ernewn[g] = ern[g];
+        }
+#endif
+        reset_state = true;
+    }
+
+    // Convert back to primitive form
+    qo_arr(i,j,k,QRHO) = rrnewn;
+    Real rhoinv = 1.0_rt / rrnewn;
+    qo_arr(i,j,k,QU) = runewn * rhoinv;
+    qo_arr(i,j,k,QV) = rvnewn * rhoinv;
+    qo_arr(i,j,k,QW) = rwnewn * rhoinv;
+
+    // note: we run the risk of (rho e) being negative here
+    Real rhoekenn = 0.5_rt * (runewn * runewn + rvnewn * rvnewn + rwnewn * rwnewn) * rhoinv;
+    qo_arr(i,j,k,QREINT) = renewn - rhoekenn;
+
+    if (!reset_state) {
+        // do the transverse terms for p, gamma, and rhoe, as necessary
+
+        if (reset_rhoe == 1 && qo_arr(i,j,k,QREINT) <= 0.0_rt) {
+            // If it is negative, reset the internal energy by
+            // using the discretized expression for updating (rho e).
+#if AMREX_SPACEDIM == 2
+            qo_arr(i,j,k,QREINT) = q_arr(i,j,k,QREINT) - hdt * (tz.dF[UEINT] + tz.pav * tz.du) * tz.volinv;
+#else
+            qo_arr(i,j,k,QREINT) = q_arr(i,j,k,QREINT) - cdtdx * (tz.dF[UEINT] + tz.pav * tz.du);
+#endif
+        }
+
+        // If (rho e) is negative by this point,
+        // set it back to the original interface state,
+        // which turns off the transverse correction.
+
+        if (qo_arr(i,j,k,QREINT) <= 0.0_rt) {
+            qo_arr(i,j,k,QREINT) = q_arr(i,j,k,QREINT);
+        }
+
+        // Pretend QREINT has been fixed and transverse_use_eos != 1.
+        // If we are wrong, we will fix it later.
+
+        // Add the transverse term to the p evolution eq here.
+#if AMREX_SPACEDIM == 2
+        // the divergences here, dup and du, already have area factors
+        Real pnewn = q_arr(i,j,k,QPRES) - hdt * (tz.dup + tz.pav * tz.du * (tz.gamc - 1.0_rt)) * tz.volinv;
+#else
+        Real pnewn = q_arr(i,j,k,QPRES) - cdtdx * (tz.dup + tz.pav * tz.du * (tz.gamc - 1.0_rt));
+#endif
+        qo_arr(i,j,k,QPRES) = amrex::max(pnewn, small_p);
+
+    }
+    else {
+        qo_arr(i,j,k,QPRES) = q_arr(i,j,k,QPRES);
+        qo_arr(i,j,k,QREINT) = q_arr(i,j,k,QREINT);
+    }
+
+#ifdef RADIATION
+    for (int g = 0; g < NGROUPS; ++g) {
+        qo_arr(i,j,k,QRAD + g) = ernewn[g];
+    }
+
+    qo_arr(i,j,k,QPTOT) = qo_arr(i,j,k,QPRES);
+    for (int g = 0; g < NGROUPS; ++g) {
+        qo_arr(i,j,k,QPTOT) += tz.lambda[g] * ernewn[g];
+    }
+
+    qo_arr(i,j,k,QREITOT) = qo_arr(i,j,k,QREINT);
+    for (int g = 0; g < NGROUPS; ++g) {
+        qo_arr(i,j,k,QREITOT) += qo_arr(i,j,k,QRAD + g);
+    }
+#endif
+}
+
+}
+
+
 void
 Castro::actual_trans_single(const Box& bx,
                             int idir_t, int idir_n, int d,
-                            Array4<Real const> const& q_arr,
-                            Array4<Real> const& qo_arr,
+                            Array4<qedge_t const> const& q_arr,
+                            Array4<qedge_t> const& qo_arr,
                             Array4<Real const> const& qaux_arr,
                             Array4<Real const> const& flux_t,
 #ifdef RADIATION
@@ -161,290 +531,160 @@ Castro::actual_trans_single(const Box& bx,
           kr += d;
         }
 
-        // Update all of the passively-advected quantities with the
-        // transverse term and convert back to the primitive quantity.
-
-#if AMREX_SPACEDIM == 2
-        const Real volinv = 1.0_rt / vol(il,jl,kl);
-#endif
-        for (int ipassive = 0; ipassive < npassive; ipassive++) {
-            int n = upassmap(ipassive);
-            int nqp = qpassmap(ipassive);
-
-#if AMREX_SPACEDIM == 2
-            Real rrnew = q_arr(i,j,k,QRHO) - hdt * (area_t(ir,jr,kr) * flux_t(ir,jr,kr,URHO) -
-                                                area_t(il,jl,kl) * flux_t(il,jl,kl,URHO)) * volinv;
-            Real compu = q_arr(i,j,k,QRHO) * q_arr(i,j,k,nqp) - hdt * (area_t(ir,jr,kr) * flux_t(ir,jr,kr,n) -
-                                                               area_t(il,jl,kl) * flux_t(il,jl,kl,n)) * volinv;
-            qo_arr(i,j,k,nqp) = compu / rrnew;
-#else
-            Real rrnew = q_arr(i,j,k,QRHO) - cdtdx * (flux_t(ir,jr,kr,URHO) - flux_t(il,jl,kl,URHO));
-            Real compu = q_arr(i,j,k,QRHO) * q_arr(i,j,k,nqp) - cdtdx * (flux_t(ir,jr,kr,n) - flux_t(il,jl,kl,n));
-            qo_arr(i,j,k,nqp) = compu / rrnew;
-#endif
-        }
-
-        Real pgp  = q_t(ir,jr,kr,GDPRES);
-        Real pgm  = q_t(il,jl,kl,GDPRES);
-        Real ugp  = q_t(ir,jr,kr,GDU+idir_t);
-        Real ugm  = q_t(il,jl,kl,GDU+idir_t);
+        trans_zone_t tz;
 
+        load_trans_zone(il, jl, kl, ir, jr, kr, idir_t,
+                        qaux_arr, flux_t,
 #ifdef RADIATION
-        Real lambda[NGROUPS];
-        Real ergp[NGROUPS];
-        Real ergm[NGROUPS];
-
-        for (int g = 0; g < NGROUPS; ++g) {
-            lambda[g] = qaux_arr(il,jl,kl,QLAMS+g);
-            ergp[g] = q_t(ir,jr,kr,GDERADS+g);
-            ergm[g] = q_t(il,jl,kl,GDERADS+g);
-        }
+                        rflux_t,
 #endif
-
-        // we need to augment our conserved system with either a p
-        // equation or gammae (if we have ppm_predict_gammae = 1) to
-        // be able to deal with the general EOS
-
+                        q_t,
 #if AMREX_SPACEDIM == 2
-        Real dup = area_t(ir,jr,kr) * pgp * ugp - area_t(il,jl,kl) * pgm * ugm;
-        Real du = area_t(ir,jr,kr) * ugp - area_t(il,jl,kl) * ugm;
-#else
-        Real dup = pgp * ugp - pgm * ugm;
-        Real du = ugp - ugm;
+                        area_t, vol,
 #endif
-        Real pav = 0.5_rt * (pgp + pgm);
 #ifdef RADIATION
-        Real uav = 0.5_rt * (ugp + ugm);
+                        fspace_t, comov, limiter, closure,
 #endif
+                        hdt, cdtdx, tz);
 
-        // this is the gas gamma_1
-#ifdef RADIATION
-        Real gamc = qaux_arr(il,jl,kl,QGAMCG);
-#else
-        Real gamc = qaux_arr(il,jl,kl,QGAMC);
-#endif
+        apply_trans_zone(i, j, k, idir_t, tz, q_arr, qo_arr,
+                         hdt, cdtdx, coord,
+                         reset_density, reset_rhoe, small_p);
 
-#ifdef RADIATION
-        Real lamge[NGROUPS];
-        Real luge[NGROUPS];
-        Real der[NGROUPS];
+    });
 
-        Real dmom = 0.0_rt;
-        Real dre = 0.0_rt;
+}
 
-        for (int g = 0; g < NGROUPS; ++g) {
-            lamge[g] = lambda[g] * (ergp[g] - ergm[g]);
-            dmom += -cdtdx * lamge[g];
-            luge[g] = uav * lamge[g];
-            dre += -cdtdx * luge[g];
-        }
 
-        if (fspace_t == 1 && comov) {
-            for (int g = 0; g < NGROUPS; ++g) {
-                Real eddf = Edd_factor(lambda[g], limiter, closure);
-                Real f1 = 0.5_rt * (1.0_rt - eddf);
-                der[g] = cdtdx * uav * f1 * (ergp[g] - ergm[g]);
-            }
-        }
-        else if (fspace_t == 2) {
-#if AMREX_SPACEDIM == 2
-            Real divu = (area_t(ir,jr,kr) * ugp - area_t(il,jl,kl) * ugm) * volinv;
-            for (int g = 0; g < NGROUPS; g++) {
-                Real eddf = Edd_factor(lambda[g], limiter, closure);
-                Real f1 = 0.5_rt * (1.0_rt - eddf);
-                der[g] = -hdt * f1 * 0.5_rt * (ergp[g] + ergm[g]) * divu;
-            }
-#else
-            for (int g = 0; g < NGROUPS; g++) {
-                Real eddf = Edd_factor(lambda[g], limiter, closure);
-                Real f1 = 0.5_rt * (1.0_rt - eddf);
-                der[g] = cdtdx * f1 * 0.5_rt * (ergp[g] + ergm[g]) * (ugm - ugp);
-            }
-#endif
-        }
-        else { // mixed frame
-            for (int g = 0; g < NGROUPS; g++) {
-                der[g] = cdtdx * luge[g];
-            }
-        }
-#endif
-
-        // Convert to conservation form
-        Real rrn = q_arr(i,j,k,QRHO);
-        Real run = rrn * q_arr(i,j,k,QU);
-        Real rvn = rrn * q_arr(i,j,k,QV);
-        Real rwn = rrn * q_arr(i,j,k,QW);
-        Real ekenn = 0.5_rt * rrn * (q_arr(i,j,k,QU) * q_arr(i,j,k,QU) + q_arr(i,j,k,QV) * q_arr(i,j,k,QV) + q_arr(i,j,k,QW) * q_arr(i,j,k,QW));
-        Real ren = q_arr(i,j,k,QREINT) + ekenn;
+#if AMREX_SPACEDIM == 3
+void
+Castro::trans_single_pair(int idir_t,
+                          const Box& bx1, int idir_n1,
+                          Array4<qedge_t const> const& qm1,
+                          Array4<qedge_t> const& qmo1,
+                          Array4<qedge_t const> const& qp1,
+                          Array4<qedge_t> const& qpo1,
+                          const Box& bx2, int idir_n2,
+                          Array4<qedge_t const> const& qm2,
+                          Array4<qedge_t> const& qmo2,
+                          Array4<qedge_t const> const& qp2,
+                          Array4<qedge_t> const& qpo2,
+                          Array4<Real const> const& qaux_arr,
+                          Array4<Real const> const& flux_t,
 #ifdef RADIATION
-        Real ern[NGROUPS];
-        for (int g = 0; g < NGROUPS; ++g) {
-            ern[g] = q_arr(i,j,k,QRAD+g);
-        }
+                          Array4<Real const> const& rflux_t,
 #endif
+                          Array4<Real const> const& q_t,
+                          Real hdt, Real cdtdx)
+{
 
-#if AMREX_SPACEDIM == 2
-        // Add transverse predictor
-        Real rrnewn = rrn - hdt * (area_t(ir,jr,kr) * flux_t(ir,jr,kr,URHO) -
-                                   area_t(il,jl,kl) * flux_t(il,jl,kl,URHO)) * volinv;
-
-        // Note that pressure may be treated specially here, depending on
-        // the geometry.  Our y-interface equation for (rho u) is:
-        //
-        //  d(rho u)/dt + d(rho u v)/dy = - 1/r d(r rho u u)/dr - dp/dr
-        //
-        // in cylindrical coords -- note that the p term is not
-        // in a divergence for UMX in the x-direction, so there
-        // are no area factors.  For this geometry, we do not
-        // include p in our definition of the flux in the
-        // x-direction, for we need to fix this now.
-        Real runewn = run - hdt * (area_t(ir,jr,kr) * flux_t(ir,jr,kr,UMX) -
-                                   area_t(il,jl,kl) * flux_t(il,jl,kl,UMX)) * volinv;
-        if (idir_t == 0 && !mom_flux_has_p(0, idir_t, coord)) {
-            runewn = runewn - cdtdx * (pgp - pgm);
-        }
-        Real rvnewn = rvn - hdt * (area_t(ir,jr,kr) * flux_t(ir,jr,kr,UMY) -
-                                   area_t(il,jl,kl) * flux_t(il,jl,kl,UMY)) * volinv;
-        Real rwnewn = rwn - hdt * (area_t(ir,jr,kr) * flux_t(ir,jr,kr,UMZ) -
-                                   area_t(il,jl,kl) * flux_t(il,jl,kl,UMZ)) * volinv;
-        Real renewn = ren - hdt * (area_t(ir,jr,kr) * flux_t(ir,jr,kr,UEDEN) -
-                                   area_t(il,jl,kl) * flux_t(il,jl,kl,UEDEN)) * volinv;
-
-#ifdef RADIATION
-        if (idir_t == 0) {
-            Real lamge_sum = 0.0_rt;
-            for (int g = 0; g < NGROUPS; ++g)
-                lamge_sum = lamge_sum + lamge[g];
-
-            runewn = runewn - 0.5_rt * hdt * (area_t(ir,jr,kr) + area_t(il,jl,kl)) * lamge_sum * volinv;
-        }
-        else {
-            rvnewn = rvnewn + dmom;
-        }
-
-        renewn = renewn + dre;
+    // This does the same work as trans_single for the states in
+    // directions idir_n1 and idir_n2, followed by
+    // reset_edge_state_thermo on each of the updated states, but in a
+    // single sweep over zones.  For each zone we load the transverse
+    // flux difference once, and then update the (up to) four interface
+    // states that sit in that zone: the plus states of its lower
+    // interfaces and the minus states of its upper interfaces in the
+    // two normal directions.
 
-        Real ernewn[NGROUPS];
-        for (int g = 0; g < NGROUPS; ++g) {
-            ernewn[g] = ern[g] - hdt * (area_t(ir,jr,kr) * rflux_t(ir,jr,kr,g) -
-                                        area_t(il,jl,kl) * rflux_t(il,jl,kl,g)) * volinv + der[g];
-        }
-#endif
+    int coord = geom.Coord();
 
-#else
-        // Add transverse predictor
-        Real rrnewn = rrn - cdtdx * (flux_t(ir,jr,kr,URHO)  - flux_t(il,jl,kl,URHO));
-        Real runewn = run - cdtdx * (flux_t(ir,jr,kr,UMX)   - flux_t(il,jl,kl,UMX));
-        Real rvnewn = rvn - cdtdx * (flux_t(ir,jr,kr,UMY)   - flux_t(il,jl,kl,UMY));
-        Real rwnewn = rwn - cdtdx * (flux_t(ir,jr,kr,UMZ)   - flux_t(il,jl,kl,UMZ));
-        Real renewn = ren - cdtdx * (flux_t(ir,jr,kr,UEDEN) - flux_t(il,jl,kl,UEDEN));
-#ifdef RADIATION
-        runewn = runewn + dmom;
-        renewn = renewn + dre;
-        Real ernewn[NGROUPS];
-        for (int g = 0; g < NGROUPS; ++g) {
-            ernewn[g] = ern[g] - cdtdx * (rflux_t(ir,jr,kr,g) - rflux_t(il,jl,kl,g)) + der[g];
-        }
-#endif
-#endif
+    bool reset_density = transverse_reset_density;
+    bool reset_rhoe = transverse_reset_rhoe;
+    int use_eos = transverse_use_eos;
+    Real small_p = small_pres;
+    Real small_t = small_temp;
 
-        // Reset to original value if adding transverse terms made density negative
-        bool reset_state = false;
-        if (reset_density == 1 && rrnewn < 0.0_rt) {
-            rrnewn = rrn;
-            runewn = run;
-            rvnewn = rvn;
-            rwnewn = rwn;
-            renewn = ren;
 #ifdef RADIATION
-            for (int g = 0; g < NGROUPS; ++g) {
-                ernewn[g] = ern[g];
-            }
+    int fspace_t = Radiation::fspace_advection_type;
+    int comov = Radiation::comoving;
+    int limiter = Radiation::limiter;
+    int closure = Radiation::closure;
 #endif
-            reset_state = true;
-        }
 
-        // Convert back to primitive form
-        qo_arr(i,j,k,QRHO) = rrnewn;
-        Real rhoinv = 1.0_rt / rrnewn;
-        qo_arr(i,j,k,QU) = runewn * rhoinv;
-        qo_arr(i,j,k,QV) = rvnewn * rhoinv;
-        qo_arr(i,j,k,QW) = rwnewn * rhoinv;
+    const IntVect e_t = IntVect::TheDimensionVector(idir_t);
+    const IntVect e_n1 = IntVect::TheDimensionVector(idir_n1);
+    const IntVect e_n2 = IntVect::TheDimensionVector(idir_n2);
 
-        // note: we run the risk of (rho e) being negative here
-        Real rhoekenn = 0.5_rt * (runewn * runewn + rvnewn * rvnewn + rwnewn * rwnewn) * rhoinv;
-        qo_arr(i,j,k,QREINT) = renewn - rhoekenn;
+    // the zones that hold any of the interface states
 
-        if (!reset_state) {
-            // do the transverse terms for p, gamma, and rhoe, as necessary
+    Box zbx = amrex::growLo(bx1, idir_n1, 1);
+    zbx.minBox(amrex::growLo(bx2, idir_n2, 1));
 
-            if (reset_rhoe == 1 && qo_arr(i,j,k,QREINT) <= 0.0_rt) {
-                // If it is negative, reset the internal energy by
-                // using the discretized expression for updating (rho e).
-#if AMREX_SPACEDIM == 2
-                qo_arr(i,j,k,QREINT) = q_arr(i,j,k,QREINT) - hdt * (area_t(ir,jr,kr) * flux_t(ir,jr,kr,UEINT) -
-                                                            area_t(il,jl,kl) * flux_t(il,jl,kl,UEINT) +
-                                                            pav * du) * volinv;
-#else
-                qo_arr(i,j,k,QREINT) = q_arr(i,j,k,QREINT) - cdtdx * (flux_t(ir,jr,kr,UEINT) - flux_t(il,jl,kl,UEINT) + pav * du);
-#endif
-            }
+    amrex::ParallelFor(zbx,
+    [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+    {
+        const IntVect iv(i, j, k);
 
-            // If (rho e) is negative by this point,
-            // set it back to the original interface state,
-            // which turns off the transverse correction.
+        const bool do_p1 = bx1.contains(iv);
+        const bool do_m1 = bx1.contains(iv + e_n1);
+        const bool do_p2 = bx2.contains(iv);
+        const bool do_m2 = bx2.contains(iv + e_n2);
 
-            if (qo_arr(i,j,k,QREINT) <= 0.0_rt) {
-                qo_arr(i,j,k,QREINT) = q_arr(i,j,k,QREINT);
-            }
+        if (!(do_p1 || do_m1 || do_p2 || do_m2)) {
+            return;
+        }
 
-            // Pretend QREINT has been fixed and transverse_use_eos != 1.
-            // If we are wrong, we will fix it later.
+        trans_zone_t tz;
 
-            // Add the transverse term to the p evolution eq here.
-#if AMREX_SPACEDIM == 2
-            // the divergences here, dup and du, already have area factors
-            Real pnewn = q_arr(i,j,k,QPRES) - hdt * (dup + pav * du * (gamc - 1.0_rt)) * volinv;
-#else
-            Real pnewn = q_arr(i,j,k,QPRES) - cdtdx * (dup + pav * du * (gamc - 1.0_rt));
+        load_trans_zone(i, j, k, i + e_t[0], j + e_t[1], k + e_t[2], idir_t,
+                        qaux_arr, flux_t,
+#ifdef RADIATION
+                        rflux_t,
 #endif
-            qo_arr(i,j,k,QPRES) = amrex::max(pnewn, small_p);
+                        q_t,
+#ifdef RADIATION
+                        fspace_t, comov, limiter, closure,
+#endif
+                        hdt, cdtdx, tz);
 
-        }
-        else {
-            qo_arr(i,j,k,QPRES) = q_arr(i,j,k,QPRES);
-            qo_arr(i,j,k,QREINT) = q_arr(i,j,k,QREINT);
+        if (do_p1) {
+            apply_trans_zone(i, j, k, idir_t, tz, qp1, qpo1,
+                             hdt, cdtdx, coord,
+                             reset_density, reset_rhoe, small_p);
+            reset_edge_state_thermo_zone(i, j, k, qpo1, use_eos, reset_rhoe, small_t, small_p);
         }
 
-#ifdef RADIATION
-        for (int g = 0; g < NGROUPS; ++g) {
-            qo_arr(i,j,k,QRAD + g) = ernewn[g];
+        if (do_m1) {
+            const int ii = i + e_n1[0];
+            const int jj = j + e_n1[1];
+            const int kk = k + e_n1[2];
+            apply_trans_zone(ii, jj, kk, idir_t, tz, qm1, qmo1,
+                             hdt, cdtdx, coord,
+                             reset_density, reset_rhoe, small_p);
+            reset_edge_state_thermo_zone(ii, jj, kk, qmo1, use_eos, reset_rhoe, small_t, small_p);
         }
 
-        qo_arr(i,j,k,QPTOT) = qo_arr(i,j,k,QPRES);
-        for (int g = 0; g < NGROUPS; ++g) {
-            qo_arr(i,j,k,QPTOT) += lambda[g] * ernewn[g];
+        if (do_p2) {
+            apply_trans_zone(i, j, k, idir_t, tz, qp2, qpo2,
+                             hdt, cdtdx, coord,
+                             reset_density, reset_rhoe, small_p);
+            reset_edge_state_thermo_zone(i, j, k, qpo2, use_eos, reset_rhoe, small_t, small_p);
         }
 
-        qo_arr(i,j,k,QREITOT) = qo_arr(i,j,k,QREINT);
-        for (int g = 0; g < NGROUPS; ++g) {
-            qo_arr(i,j,k,QREITOT) += qo_arr(i,j,k,QRAD + g);
+        if (do_m2) {
+            const int ii = i + e_n2[0];
+            const int jj = j + e_n2[1];
+            const int kk = k + e_n2[2];
+            apply_trans_zone(ii, jj, kk, idir_t, tz, qm2, qmo2,
+                             hdt, cdtdx, coord,
+                             reset_density, reset_rhoe, small_p);
+            reset_edge_state_thermo_zone(ii, jj, kk, qmo2, use_eos, reset_rhoe, small_t, small_p);
         }
-#endif
-
     });
 
 }
+#endif
 
 
 
 void
 Castro::trans_final(const Box& bx,
                     int idir_n, int idir_t1, int idir_t2,
-                    Array4<Real const> const& qm,
-                    Array4<Real> const& qmo,
-                    Array4<Real const> const& qp,
-                    Array4<Real> const& qpo,
+                    Array4<qedge_t const> const& qm,
+                    Array4<qedge_t> const& qmo,
+                    Array4<qedge_t const> const& qp,
+                    Array4<qedge_t> const& qpo,
                     Array4<Real const> const& qaux_arr,
                     Array4<Real const> const& flux_t1,
 #ifdef RADIATION
@@ -498,8 +738,8 @@ Castro::trans_final(const Box& bx,
 void
 Castro::actual_trans_final(const Box& bx,
                            int idir_n, int idir_t1, int idir_t2, int d,
-                           Array4<Real const> const& q_arr,
-                           Array4<Real> const& qo_arr,
+                           Array4<qedge_t const> const& q_arr,
+                           Array4<qedge_t> const& qo_arr,
                            Array4<Real const> const& qaux_arr,
                            Array4<Real const> const& flux_t1,
 #ifdef RADIATION
@@ -839,7 +1079,7 @@ Castro::actual_trans_final(const Box& bx,
             qo_arr(i,j,k,QREINT) = q_arr(i,j,k,QREINT);
         }
 
-        qo_arr(i,j,k,QPRES) = amrex::max(qo_arr(i,j,k,QPRES), small_p);
+        qo_arr(i,j,k,QPRES) = amrex::max<Real>(qo_arr(i,j,k,QPRES), small_p);
 
 #ifdef RADIATION
         for (int g = 0; g < NGROUPS; ++g) {
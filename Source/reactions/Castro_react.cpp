@@ -1,14 +1,599 @@
 
 #include <Castro.H>
 #include <Castro_F.H>
+#include <Castro_react_zone.H>
+
+#include <algorithm>
+#include <cstdint>
 
 using std::string;
 using namespace amrex;
 
+void
+Castro::build_burn_lists(const MultiFab& U, const MultiFab& U_shock,
+                         const MultiFab& weights, const int ng,
+                         Vector<BurnZoneList>& lists,
+                         const iMultiFab* skip)
+{
+    BL_PROFILE("Castro::build_burn_lists()");
+
+    lists.clear();
+    lists.resize(U.local_size());
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(U); mfi.isValid(); ++mfi) {
+
+        const Box& bx = mfi.growntilebox(ng);
+
+        const auto lo = amrex::lbound(bx);
+        const auto len = amrex::length(bx);
+        const int npts = static_cast<int>(bx.numPts());
+
+        auto U_arr = U.const_array(mfi);
+        auto U_shock_arr = U_shock.const_array(mfi);
+        auto w = weights.const_array(mfi);
+
+        const bool use_skip = skip != nullptr;
+        auto skip_arr = use_skip ? skip->const_array(mfi) : Array4<int const>{};
+
+        // compact the zones that will burn, storing their offset in
+        // the box and their expected cost
+
+        Gpu::DeviceVector<int> zone(npts);
+        Gpu::DeviceVector<Real> cost(npts);
+
+        int* const zone_ptr = zone.data();
+        Real* const cost_ptr = cost.data();
+
+        const int nburn =
+            Scan::PrefixSum<int>(npts,
+                                 [=] AMREX_GPU_DEVICE (int m) -> int
+                                 {
+                                     const int i = lo.x + m % len.x;
+                                     const int j = lo.y + (m / len.x) % len.y;
+                                     const int k = lo.z + m / (len.x * len.y);
+                                     const bool skipped = use_skip && skip_arr(i,j,k) > 0;
+                                     return (!skipped && zone_will_burn(i, j, k, U_arr, U_shock_arr)) ? 1 : 0;
+                                 },
+                                 [=] AMREX_GPU_DEVICE (int m, int const& s)
+                                 {
+                                     const int i = lo.x + m % len.x;
+                                     const int j = lo.y + (m / len.x) % len.y;
+                                     const int k = lo.z + m / (len.x * len.y);
+                                     const bool skipped = use_skip && skip_arr(i,j,k) > 0;
+                                     if (!skipped && zone_will_burn(i, j, k, U_arr, U_shock_arr)) {
+                                         zone_ptr[s] = m;
+                                         // the weights may not cover the ghost
+                                         // cells, and may not be set yet
+                                         cost_ptr[s] = (w.contains(i,j,k) && w(i,j,k,1) > 0.0_rt) ? w(i,j,k,1) : 1.0_rt;
+                                     }
+                                 },
+                                 Scan::Type::exclusive, Scan::retSum);
+
+        // put the most expensive zones first.  On GPUs this puts zones
+        // of similar cost next to each other, so the threads of a block
+        // finish together, and burn_zones_dynamic merges the lists of all
+        // of the boxes in this order.  The sort is done on the host.
+
+        Vector<int> h_zone(nburn);
+        Vector<Real> h_cost(nburn);
+
+        Gpu::copy(Gpu::deviceToHost, zone.begin(), zone.begin() + nburn, h_zone.begin());
+        Gpu::copy(Gpu::deviceToHost, cost.begin(), cost.begin() + nburn, h_cost.begin());
+
+        Vector<int> order(nburn);
+        for (int n = 0; n < nburn; ++n) {
+            order[n] = n;
+        }
+
+        std::stable_sort(order.begin(), order.end(),
+                         [&] (const int a, const int b) { return h_cost[a] > h_cost[b]; });
+
+        Vector<int> sorted_zone(nburn);
+        Vector<Real> sorted_cost(nburn);
+        for (int n = 0; n < nburn; ++n) {
+            sorted_zone[n] = h_zone[order[n]];
+            sorted_cost[n] = h_cost[order[n]];
+        }
+
+        BurnZoneList& list = lists[mfi.LocalIndex()];
+
+        list.i.resize(nburn);
+        list.j.resize(nburn);
+        list.k.resize(nburn);
+        list.cost.resize(nburn);
+
+        Gpu::copy(Gpu::hostToDevice, sorted_zone.begin(), sorted_zone.end(), zone.begin());
+        Gpu::copy(Gpu::hostToDevice, sorted_cost.begin(), sorted_cost.end(), list.cost.begin());
+
+        int* const zi = list.i.data();
+        int* const zj = list.j.data();
+        int* const zk = list.k.data();
+
+        amrex::ParallelFor(nburn,
+        [=] AMREX_GPU_HOST_DEVICE (int n)
+        {
+            const int m = zone_ptr[n];
+            zi[n] = lo.x + m % len.x;
+            zj[n] = lo.y + (m / len.x) % len.y;
+            zk[n] = lo.z + m / (len.x * len.y);
+        });
+
+        // zone and cost go out of scope here
+
+        Gpu::streamSynchronize();
+    }
+}
+
+template <typename F>
+Real
+Castro::burn_zones_dynamic(const MultiFab& mf, const int ng,
+                           const Vector<BurnZoneList>& lists,
+                           Vector<Real>* thread_time,
+                           F&& burn_zone)
+{
+    BL_PROFILE("Castro::burn_zones_dynamic()");
+
+    // Number the zones of the boxes on this rank consecutively, so
+    // that a flat zone index identifies both the box and the zone.
+    // The burn cost varies by orders of magnitude from zone to zone,
+    // so the threads take small chunks of zones from this list as they
+    // finish their last one instead of being handed whole tiles.
+    //
+    // With packed lists, the zones of all of the boxes are instead
+    // handed out in a single order by their expected cost, most
+    // expensive first, so that the expensive zones of every box are
+    // started before any of the cheap ones.
+
+    const int nboxes = mf.local_size();
+    const bool packed = !lists.empty();
+
+    Vector<Box> boxes(nboxes);
+    Vector<Long> offset(nboxes + 1, 0);
+
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        boxes[mfi.LocalIndex()] = mfi.growntilebox(ng);
+    }
+
+    for (int li = 0; li < nboxes; ++li) {
+        offset[li+1] = offset[li] + (packed ? lists[li].size() : boxes[li].numPts());
+    }
+
+    const Vector<int>& box_index = mf.IndexArray();
+
+    const Long nzones = offset[nboxes];
+
+    Vector<int> order_box;
+    Vector<int> order_zone;
+    Vector<Real> order_cost;
+
+    if (packed) {
+
+        // the lists are on the host here, since this is only used on CPUs
+
+        Vector<int> flat_box(nzones);
+        Vector<Real> flat_cost(nzones);
+
+        for (int li = 0; li < nboxes; ++li) {
+            for (int n = 0; n < lists[li].size(); ++n) {
+                flat_box[offset[li] + n] = li;
+                flat_cost[offset[li] + n] = lists[li].cost[n];
+            }
+        }
+
+        Vector<Long> order(nzones);
+        for (Long z = 0; z < nzones; ++z) {
+            order[z] = z;
+        }
+
+        std::stable_sort(order.begin(), order.end(),
+                         [&] (const Long a, const Long b) { return flat_cost[a] > flat_cost[b]; });
+
+        order_box.resize(nzones);
+        order_zone.resize(nzones);
+        order_cost.resize(nzones);
+
+        for (Long z = 0; z < nzones; ++z) {
+            const Long zz = order[z];
+            order_box[z] = flat_box[zz];
+            order_zone[z] = static_cast<int>(zz - offset[flat_box[zz]]);
+            order_cost[z] = flat_cost[zz];
+        }
+
+    }
+    const Long chunk = amrex::max(1, react_dynamic_chunk);
+    const Long nchunks = (nzones + chunk - 1) / chunk;
+
+    // We only read the clock at the ends of a chunk and when a chunk
+    // moves on to the next box.  Each thread adds up the cost of each
+    // box it worked on, and we record the box costs once at the end.
+    // In the global order of the packed lists, consecutive zones are
+    // usually in different boxes, so there we instead split the time
+    // of a chunk between its zones by their expected cost.
+
+    const bool time_boxes = rebalance_int > 0;
+    const bool time_threads = thread_time != nullptr;
+
+    Vector<Vector<Real>> thread_box_cost;
+    if (time_boxes) {
+        thread_box_cost.resize(OpenMP::get_max_threads(), Vector<Real>(nboxes, 0.0));
+    }
+
+    Real burn_failed = 0.0;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) reduction(+:burn_failed)
+#endif
+    for (Long c = 0; c < nchunks; ++c) {
+
+        const Long zlo = c * chunk;
+        const Long zhi = amrex::min(zlo + chunk, nzones);
+
+        const int tid = OpenMP::get_thread_num();
+
+        const Real chunk_start_time = (time_boxes || time_threads) ? ParallelDescriptor::second() : 0.0;
+        Real box_start_time = chunk_start_time;
+
+        int li = static_cast<int>(std::upper_bound(offset.begin(), offset.end(), zlo) - offset.begin()) - 1;
+
+        for (Long z = zlo; z < zhi; ++z) {
+
+            int i, j, k;
+
+            if (packed) {
+                li = order_box[z];
+                const int n = order_zone[z];
+                i = lists[li].i[n];
+                j = lists[li].j[n];
+                k = lists[li].k[n];
+            } else {
+                if (z >= offset[li+1]) {
+                    if (time_boxes) {
+                        const Real now = ParallelDescriptor::second();
+                        thread_box_cost[tid][li] += now - box_start_time;
+                        box_start_time = now;
+                    }
+
+                    // skip over any boxes without zones to burn
+                    while (z >= offset[li+1]) {
+                        ++li;
+                    }
+                }
+
+                const IntVect iv = boxes[li].atOffset(z - offset[li]);
+                i = iv[0];
+                j = 0;
+                k = 0;
+#if AMREX_SPACEDIM >= 2
+                j = iv[1];
+#endif
+#if AMREX_SPACEDIM == 3
+                k = iv[2];
+#endif
+            }
+
+            burn_failed += burn_zone(li, i, j, k);
+
+        }
+
+        if (time_boxes || time_threads) {
+            const Real now = ParallelDescriptor::second();
+            if (time_boxes && packed) {
+                Real chunk_cost = 0.0;
+                for (Long z = zlo; z < zhi; ++z) {
+                    chunk_cost += order_cost[z];
+                }
+                for (Long z = zlo; z < zhi; ++z) {
+                    thread_box_cost[tid][order_box[z]] += (now - chunk_start_time) * order_cost[z] / chunk_cost;
+                }
+            } else if (time_boxes) {
+                thread_box_cost[tid][li] += now - box_start_time;
+            }
+            if (time_threads) {
+                (*thread_time)[tid] += now - chunk_start_time;
+            }
+        }
+
+    }
+
+    if (time_boxes) {
+        for (int li = 0; li < nboxes; ++li) {
+            Real cost = 0.0;
+            for (const auto& tc : thread_box_cost) {
+                cost += tc[li];
+            }
+            add_box_cost(box_index[li], cost);
+        }
+    }
+
+    return burn_failed;
+}
+
+void
+Castro::skip_slow_burning_zones(MultiFab& s, MultiFab& r, const Real dt)
+{
+    BL_PROFILE("Castro::skip_slow_burning_zones()");
+
+    const int ng = s.nGrow();
+
+    const int recheck_int = react_skip_recheck_int;
+    const Real tol = react_skip_tolerance;
+
+    // start by burning everywhere, since we have no rates yet
+
+    if (burn_skip_count.empty() || burn_skip_count.nGrow() < ng) {
+        burn_skip_count.define(grids, dmap, 1, ng);
+        burn_skip_count.setVal(recheck_int);
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(s, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+
+        const Box& bx = mfi.growntilebox(ng);
+
+        auto U = s.array(mfi);
+        auto reactions = r.array(mfi);
+        auto count = burn_skip_count.array(mfi);
+
+        amrex::ParallelFor(bx,
+        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+        {
+            // we need the rates of the last burn, and we need to burn
+            // once in a while to get new ones
+
+            if (!reactions.contains(i,j,k) || count(i,j,k) >= recheck_int) {
+                count(i,j,k) = 0;
+                return;
+            }
+
+            bool skip = std::abs(reactions(i,j,k,0)) * dt <= tol * std::abs(U(i,j,k,UEINT));
+
+            for (int n = 0; n < NumSpec + NumAux; ++n) {
+                const Real drhoX = reactions(i,j,k,2+n) * dt;
+                const int comp = n < NumSpec ? UFS + n : UFX + (n - NumSpec);
+                if (std::abs(drhoX) > tol * U(i,j,k,URHO) || U(i,j,k,comp) + drhoX < 0.0_rt) {
+                    skip = false;
+                }
+            }
+
+            if (!skip) {
+                count(i,j,k) = 0;
+                return;
+            }
+
+            // apply the rates of the last burn
+
+            for (int n = 0; n < NumSpec; ++n) {
+                U(i,j,k,UFS+n) += reactions(i,j,k,2+n) * dt;
+            }
+#if NAUX_NET > 0
+            for (int n = 0; n < NumAux; ++n) {
+                U(i,j,k,UFX+n) += reactions(i,j,k,2+NumSpec+n) * dt;
+            }
+#endif
+            U(i,j,k,UEINT) += reactions(i,j,k,0) * dt;
+            U(i,j,k,UEDEN) += reactions(i,j,k,0) * dt;
+
+            // skipping is cheap
+
+            reactions(i,j,k,1) = 1.0_rt;
+
+            count(i,j,k) += 1;
+        });
+    }
+}
+
+MultiFab*
+Castro::burn_stats_data(MultiFab& stats_tmp)
+{
+    MultiFab* stats = nullptr;
+
+    if (Burn_Stats_Type >= 0) {
+        stats = &get_new_data(Burn_Stats_Type);
+    } else if (react_stats == 1) {
+        stats_tmp.define(grids, dmap, 3, 0);
+        stats = &stats_tmp;
+    }
+
+    if (stats != nullptr) {
+        stats->setVal(0.0);
+    }
+
+    return stats;
+}
+
+void
+Castro::write_burn_stats(const MultiFab& stats, const Vector<Real>& thread_time,
+                         const Real time, const Real dt)
+{
+    BL_PROFILE("Castro::write_burn_stats()");
+
+    // The counts are: the histograms of the number of RHS and Jacobian
+    // evaluations in the zones that burned, followed by the number of
+    // zones that burned, skipped their burn, and failed.
+
+    const int nbins = burn_stats_nbins;
+    const int ncounts = 2 * nbins + 3;
+
+    Gpu::DeviceVector<int> counts_d(ncounts, 0);
+    int* const counts_ptr = counts_d.data();
+
+    for (MFIter mfi(stats); mfi.isValid(); ++mfi) {
+
+        const Box& bx = mfi.validbox();
+
+        auto burn_stats = stats.const_array(mfi);
+
+        amrex::ParallelFor(bx,
+        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+        {
+            const int status = static_cast<int>(burn_stats(i,j,k,2));
+
+            if (status == burn_status_burned || status == burn_status_failed) {
+                Gpu::Atomic::AddNoRet(&counts_ptr[burn_stats_bin(burn_stats(i,j,k,0), nbins)], 1);
+                Gpu::Atomic::AddNoRet(&counts_ptr[nbins + burn_stats_bin(burn_stats(i,j,k,1), nbins)], 1);
+                Gpu::Atomic::AddNoRet(&counts_ptr[2 * nbins], 1);
+            }
+
+            if (status == burn_status_skipped) {
+                Gpu::Atomic::AddNoRet(&counts_ptr[2 * nbins + 1], 1);
+            }
+
+            if (status == burn_status_failed) {
+                Gpu::Atomic::AddNoRet(&counts_ptr[2 * nbins + 2], 1);
+            }
+        });
+    }
+
+    Vector<int> counts_h(ncounts);
+    Gpu::copy(Gpu::deviceToHost, counts_d.begin(), counts_d.end(), counts_h.begin());
+
+    // The locations of the zones that failed on this rank.  There
+    // should be few of these, so we find them on the host.
+
+    Vector<int> fail_loc;
+
+    if (counts_h[2 * nbins + 2] > 0) {
+
+        for (MFIter mfi(stats); mfi.isValid(); ++mfi) {
+
+            const Box& bx = mfi.validbox();
+
+#ifdef AMREX_USE_GPU
+            FArrayBox status_fab(bx, 1, The_Pinned_Arena());
+            status_fab.copy<RunOn::Device>(stats[mfi], bx, 2, bx, 0, 1);
+            Gpu::streamSynchronize();
+            auto status = status_fab.const_array();
+#else
+            auto status = stats.const_array(mfi, 2);
+#endif
+
+            amrex::LoopOnCpu(bx, [&] (int i, int j, int k)
+            {
+                if (static_cast<int>(status(i,j,k)) == burn_status_failed) {
+                    fail_loc.push_back(i);
+                    fail_loc.push_back(j);
+                    fail_loc.push_back(k);
+                }
+            });
+        }
+    }
+
+    // Collect everything on the I/O processor.
+
+    const int IOProc = ParallelDescriptor::IOProcessorNumber();
+    const int nprocs = ParallelDescriptor::NProcs();
+
+    Vector<Long> counts(ncounts);
+    for (int n = 0; n < ncounts; ++n) {
+        counts[n] = counts_h[n];
+    }
+
+    ParallelDescriptor::ReduceLongSum(counts.data(), ncounts, IOProc);
+
+    int nthreads = static_cast<int>(thread_time.size());
+    ParallelDescriptor::ReduceIntMax(nthreads);
+
+    Vector<Real> local_time(nthreads, 0.0);
+    std::copy(thread_time.begin(), thread_time.end(), local_time.begin());
+
+    Vector<Real> all_time(ParallelDescriptor::IOProcessor() ? nprocs * nthreads : 0);
+    ParallelDescriptor::Gather(local_time.data(), nthreads, all_time.data(), nthreads, IOProc);
+
+    int nloc = static_cast<int>(fail_loc.size());
+    std::vector<int> loc_counts(nprocs, 0);
+    ParallelDescriptor::Gather(&nloc, 1, loc_counts.data(), 1, IOProc);
+
+    std::vector<int> loc_disp(nprocs, 0);
+    for (int p = 1; p < nprocs; ++p) {
+        loc_disp[p] = loc_disp[p-1] + loc_counts[p-1];
+    }
+
+    const int nloc_total = ParallelDescriptor::IOProcessor() ? loc_disp[nprocs-1] + loc_counts[nprocs-1] : 0;
+    Vector<int> all_loc(nloc_total);
+    ParallelDescriptor::Gatherv(fail_loc.data(), nloc, all_loc.data(), loc_counts, loc_disp, IOProc);
+
+    if (verbose > 0) {
+        Real max_time = 0.0;
+        Real sum_time = 0.0;
+        for (Real t : all_time) {
+            max_time = amrex::max(max_time, t);
+            sum_time += t;
+        }
+        const Real mean_time = all_time.empty() ? 0.0 : sum_time / static_cast<Real>(all_time.size());
+
+        amrex::Print() << "... burn statistics on level " << level << ": "
+                       << counts[2 * nbins] << " zones burned, "
+                       << counts[2 * nbins + 1] << " skipped, "
+                       << counts[2 * nbins + 2] << " failed; "
+                       << "thread burn time max / mean = " << max_time << " / " << mean_time
+                       << std::endl << std::endl;
+    }
+
+    if (!ParallelDescriptor::IOProcessor()) {
+        return;
+    }
+
+    // Append a record to the log.  See the documentation of
+    // castro.react_stats for the layout.
+
+    if (!burn_stats_log) {
+        burn_stats_log.reset(new std::fstream);
+        burn_stats_log->open("burn_stats.bin", std::ios::out | std::ios::app | std::ios::binary);
+        if (!burn_stats_log->good()) {
+            amrex::FileOpenFailed("burn_stats.bin");
+        }
+    }
+
+    std::ostream& log = *burn_stats_log;
+
+    const auto write_int = [&] (const int v) {
+        const std::int32_t w = v;
+        log.write(reinterpret_cast<const char*>(&w), sizeof(w));
+    };
+
+    const auto write_long = [&] (const Long v) {
+        const std::int64_t w = v;
+        log.write(reinterpret_cast<const char*>(&w), sizeof(w));
+    };
+
+    const auto write_real = [&] (const Real v) {
+        const double w = v;
+        log.write(reinterpret_cast<const char*>(&w), sizeof(w));
+    };
+
+    write_int(level);
+    write_int(parent->levelSteps(level));
+    write_real(time);
+    write_real(dt);
+
+    write_int(nbins);
+    for (int n = 0; n < ncounts; ++n) {
+        write_long(counts[n]);
+    }
+
+    write_int(nprocs);
+    write_int(nthreads);
+    for (Real t : all_time) {
+        write_real(t);
+    }
+
+    write_int(nloc_total / 3);
+    for (int v : all_loc) {
+        write_int(v);
+    }
+
+    log.flush();
+}
+
 // Strang version
 
 bool
-Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt)
+Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt, MultiFab* rates)
 {
     BL_PROFILE("Castro::react_state()");
 
@@ -30,6 +615,20 @@ Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt)
 
     int burn_success = 1;
 
+    // Only the zones that we burn below get rates.
+
+    if (rates != nullptr) {
+        rates->setVal(0.0, 0, 1, 0);
+    }
+
+    // Optionally record the statistics of the burn in each zone, and
+    // the time each thread spends burning.
+
+    MultiFab stats_tmp;
+    MultiFab* stats = burn_stats_data(stats_tmp);
+
+    Vector<Real> thread_time(OpenMP::get_max_threads(), 0.0);
+
     if (do_react != 1) {
 
         // Ensure we always have valid data, even if we don't do the burn.
@@ -56,141 +655,281 @@ Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt)
         amrex::Print() << "... Entering burner and doing half-timestep of burning." << std::endl << std::endl;
     }
 
-    ReduceOps<ReduceOpSum> reduce_op;
-    ReduceData<Real> reduce_data(reduce_op);
-    using ReduceTuple = typename decltype(reduce_data)::Type;
+    // Optionally skip the zones that are burning slowly.  These are
+    // updated here, and are left alone by the burn below.
+
+    const bool skip_burns = react_skip_tolerance > 0.0;
+
+    if (skip_burns) {
+        skip_slow_burning_zones(s, r, dt);
+    }
+
+    // Optionally pack the zones that will burn.  Any zone that is not
+    // in the lists (and did not skip its burn) does not burn, so it gets
+    // the reaction data of an unburned zone here.
+
+    const bool pack_zones = react_pack_zones == 1;
+
+    Vector<BurnZoneList> burn_lists;
+
+    if (pack_zones) {
+        build_burn_lists(s, s, r, ng, burn_lists, skip_burns ? &burn_skip_count : nullptr);
 
 #ifdef _OPENMP
-#pragma omp parallel
+#pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
-    for (MFIter mfi(s, TilingIfNotGPU()); mfi.isValid(); ++mfi)
-    {
+        for (MFIter mfi(r, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
 
-        const Box& bx = mfi.growntilebox(ng);
+            const Box& bx = mfi.growntilebox();
 
-        auto U = s.array(mfi);
-        auto reactions = r.array(mfi);
+            auto reactions = r.array(mfi);
+            auto skip = skip_burns ? burn_skip_count.const_array(mfi) : Array4<int const>{};
 
-        reduce_op.eval(bx, reduce_data,
-        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> ReduceTuple
-        {
+            amrex::ParallelFor(bx, r.nComp(),
+            [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k, int n)
+            {
+                if (skip_burns && skip(i,j,k) > 0) {
+                    return;
+                }
+                reactions(i,j,k,n) = (n == 1) ? 1.0_rt : 0.0_rt;
+            });
+        }
+    }
 
-            burn_t burn_state;
+    // With a localized retry, the burns that fail leave their zone
+    // alone and are marked here, so that we can burn them again below.
 
-            // Initialize some data for later.
+    const bool local_retry = react_local_retry == 1;
 
-            bool do_burn = true;
-            burn_state.success = true;
-            Real burn_failed = 0.0_rt;
+    iMultiFab failed_zones;
 
-            // Don't burn on zones inside shock regions, if the relevant option is set.
+    if (local_retry) {
+        failed_zones.define(s.boxArray(), s.DistributionMap(), 1, ng);
+        failed_zones.setVal(0);
+    }
 
-#ifdef SHOCK_VAR
-            if (U(i,j,k,USHK) > 0.0_rt && disable_shock_burning == 1) {
-                do_burn = false;
-            }
-#endif
+    Real burn_failed = 0.0;
 
-            Real rhoInv = 1.0_rt / U(i,j,k,URHO);
+    if (react_dynamic_schedule == 1 && Gpu::notInLaunchRegion()) {
 
-            burn_state.rho = U(i,j,k,URHO);
-            burn_state.T   = U(i,j,k,UTEMP);
-            burn_state.e   = 0.0_rt; // Energy generated by the burn
+        Vector<Array4<Real>> U_arr(s.local_size());
+        Vector<Array4<Real>> reactions_arr(s.local_size());
+        Vector<Array4<int const>> skip_arr(s.local_size());
+        Vector<Array4<int>> failed_arr(s.local_size());
+        Vector<Array4<Real>> rates_arr(s.local_size());
+        Vector<Array4<Real>> stats_arr(s.local_size());
 
-            for (int n = 0; n < NumSpec; ++n) {
-                burn_state.xn[n] = U(i,j,k,UFS+n) * rhoInv;
+        for (MFIter mfi(s); mfi.isValid(); ++mfi) {
+            U_arr[mfi.LocalIndex()] = s.array(mfi);
+            reactions_arr[mfi.LocalIndex()] = r.array(mfi);
+            if (skip_burns) {
+                skip_arr[mfi.LocalIndex()] = burn_skip_count.const_array(mfi);
+            }
+            if (local_retry) {
+                failed_arr[mfi.LocalIndex()] = failed_zones.array(mfi);
+            }
+            if (rates != nullptr) {
+                rates_arr[mfi.LocalIndex()] = rates->array(mfi);
+            }
+            if (stats != nullptr) {
+                stats_arr[mfi.LocalIndex()] = stats->array(mfi);
             }
+        }
 
-#if NAUX_NET > 0
-            for (int n = 0; n < NumAux; ++n) {
-                burn_state.aux[n] = U(i,j,k,UFX+n) * rhoInv;
+        burn_failed = burn_zones_dynamic(s, ng, burn_lists, stats != nullptr ? &thread_time : nullptr,
+        [&] (const int li, const int i, const int j, const int k) -> Real
+        {
+            if (skip_burns && skip_arr[li](i,j,k) > 0) {
+                return 0.0_rt;
             }
+
+            return burn_zone_strang(i, j, k, U_arr[li], reactions_arr[li], dt,
+                                    failed_arr[li], rates_arr[li], stats_arr[li]);
+        });
+
+    } else {
+
+        ReduceOps<ReduceOpSum> reduce_op;
+        ReduceData<Real> reduce_data(reduce_op);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+
+        // the burn lists are per box, so we do not tile then
+
+        const MFItInfo react_tiling = pack_zones ? MFItInfo() : get_react_tiling();
+
+#ifdef _OPENMP
+#pragma omp parallel
 #endif
+        for (MFIter mfi(s, react_tiling); mfi.isValid(); ++mfi)
+        {
 
-            // Ensure we start with no RHS or Jacobian calls registered.
+            const Real box_start_time = box_timer_start();
 
-            burn_state.n_rhs = 0;
-            burn_state.n_jac = 0;
+            auto U = s.array(mfi);
+            auto reactions = r.array(mfi);
+            auto skip = skip_burns ? burn_skip_count.const_array(mfi) : Array4<int const>{};
+            auto failed = local_retry ? failed_zones.array(mfi) : Array4<int>{};
+            auto burn_rates_arr = rates != nullptr ? rates->array(mfi) : Array4<Real>{};
+            auto burn_stats = stats != nullptr ? stats->array(mfi) : Array4<Real>{};
 
-            // Don't burn if we're outside of the relevant (rho, T) range.
+            const Real thread_start_time = stats != nullptr ? ParallelDescriptor::second() : 0.0;
 
-            if (burn_state.T < castro::react_T_min || burn_state.T > castro::react_T_max ||
-                burn_state.rho < castro::react_rho_min || burn_state.rho > castro::react_rho_max) {
-                do_burn = false;
-            }
+            if (pack_zones) {
+
+                const BurnZoneList& list = burn_lists[mfi.LocalIndex()];
+
+                const int* const zi = list.i.data();
+                const int* const zj = list.j.data();
+                const int* const zk = list.k.data();
+
+                reduce_op.eval(list.size(), reduce_data,
+                [=] AMREX_GPU_HOST_DEVICE (int n) -> ReduceTuple
+                {
+                    return {burn_zone_strang(zi[n], zj[n], zk[n], U, reactions, dt, failed,
+                                             burn_rates_arr, burn_stats)};
+                });
+
+            } else {
+
+                const Box& bx = mfi.growntilebox(ng);
+
+                reduce_op.eval(bx, reduce_data,
+                [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> ReduceTuple
+                {
+                    if (skip_burns && skip(i,j,k) > 0) {
+                        return {0.0_rt};
+                    }
+                    return {burn_zone_strang(i, j, k, U, reactions, dt, failed,
+                                             burn_rates_arr, burn_stats)};
+                });
 
-            if (do_burn) {
-                burner(burn_state, dt);
             }
 
-            // If we were unsuccessful, update the failure count.
+            record_box_cost(mfi.index(), box_start_time);
 
-            if (!burn_state.success) {
-                burn_failed = 1.0_rt;
+            if (stats != nullptr) {
+                Gpu::streamSynchronize();
+                thread_time[OpenMP::get_thread_num()] += ParallelDescriptor::second() - thread_start_time;
             }
 
-            if (do_burn) {
+        }
 
-                // Add burning rates to reactions MultiFab, but be
-                // careful because the reactions and state MFs may
-                // not have the same number of ghost cells.
+        ReduceTuple hv = reduce_data.value();
+        burn_failed = amrex::get<0>(hv);
 
-                if (reactions.contains(i,j,k)) {
+        if (!pack_zones) {
+            record_tile_timing(react_tile_tuner[level], strt_time);
+        }
 
-                    reactions(i,j,k,0) = U(i,j,k,URHO) * burn_state.e / dt;
-                    reactions(i,j,k,1) = amrex::max(1.0_rt, static_cast<Real>(burn_state.n_rhs + 2 * burn_state.n_jac));
+    }
 
-                    if (store_omegadot == 1) {
-                        if (reactions.contains(i,j,k)) {
-                            for (int n = 0; n < NumSpec; ++n) {
-                                reactions(i,j,k,2+n) = U(i,j,k,URHO) * (burn_state.xn[n] - U(i,j,k,UFS+n) * rhoInv) / dt;
-                            }
-#if NAUX_NET > 0
-                            for (int n = 0; n < NumAux; ++n) {
-                                reactions(i,j,k,2+n+NumSpec) = U(i,j,k,URHO) * (burn_state.aux[n] - U(i,j,k,UFX+n) * rhoInv) / dt;
-                            }
+    // Burn the zones that failed again, with substeps.  Only if this
+    // fails too do we report the failure, which leads to a retry of
+    // the whole advance.
+
+    if (local_retry && burn_failed != 0.0) {
+
+        if (verbose > 0) {
+            amrex::AllPrint() << "... retrying " << static_cast<Long>(burn_failed)
+                              << " failed burns with substeps on rank "
+                              << ParallelDescriptor::MyProc() << std::endl;
+        }
+
+        const int max_substeps = react_local_retry_max_substeps;
+
+        ReduceOps<ReduceOpSum> reduce_op;
+        ReduceData<Real> reduce_data(reduce_op);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+
+#ifdef _OPENMP
+#pragma omp parallel
 #endif
-                        }
-                    }
-                }
+        for (MFIter mfi(s, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.growntilebox(ng);
 
-                // update the state
+            auto U = s.array(mfi);
+            auto reactions = r.array(mfi);
+            auto failed = failed_zones.const_array(mfi);
 
-                for (int n = 0; n < NumSpec; ++n) {
-                    U(i,j,k,UFS+n) = U(i,j,k,URHO) * burn_state.xn[n];
-                }
-#if NAUX_NET > 0
-                for (int n = 0; n < NumAux; ++n) {
-                    U(i,j,k,UFX+n) = U(i,j,k,URHO) * burn_state.aux[n];
+            reduce_op.eval(bx, reduce_data,
+            [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> ReduceTuple
+            {
+                if (failed(i,j,k) == 0) {
+                    return {0.0_rt};
                 }
+                return {burn_zone_strang_substepped(i, j, k, U, reactions, dt, max_substeps)};
+            });
+        }
+
+        ReduceTuple hv = reduce_data.value();
+        burn_failed = amrex::get<0>(hv);
+
+    }
+
+    // The zones that skipped their burn were updated with the rates in
+    // the reaction data, so those are their rates too.
+
+    if (rates != nullptr && skip_burns) {
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
-                U(i,j,k,UEINT) += U(i,j,k,URHO) * burn_state.e;
-                U(i,j,k,UEDEN) += U(i,j,k,URHO) * burn_state.e;
+        for (MFIter mfi(*rates, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
 
-            } else {
+            const Box& bx = mfi.tilebox();
 
-                if (reactions.contains(i,j,k)) {
-                    reactions(i,j,k,0) = 0.0_rt;
-                    reactions(i,j,k,1) = 1.0_rt;
+            auto U = s.const_array(mfi);
+            auto reactions = r.const_array(mfi);
+            auto skip = burn_skip_count.const_array(mfi);
+            auto burn_rates_arr = rates->array(mfi);
 
-                    if (store_omegadot == 1) {
-                        for (int n = 0; n < NumSpec + NumAux; ++n) {
-                            reactions(i,j,k,2+n) = 0.0_rt;
-                        }
-                    }
+            amrex::ParallelFor(bx,
+            [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+            {
+                if (skip(i,j,k) <= 0) {
+                    return;
                 }
 
-            }
+                Real rhoInv = 1.0_rt / U(i,j,k,URHO);
+
+                burn_rates_arr(i,j,k,0) = 1.0_rt;
+                burn_rates_arr(i,j,k,1) = reactions(i,j,k,0) * rhoInv;
+                for (int n = 0; n < NumSpec; ++n) {
+                    burn_rates_arr(i,j,k,2+n) = reactions(i,j,k,2+n) * rhoInv;
+                }
+            });
+        }
+    }
 
+    // The zones that skipped their burn are not touched by the burn, so
+    // we mark them here.
 
-            return {burn_failed};
+    if (stats != nullptr && skip_burns) {
 
-        });
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(*stats, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
 
+            const Box& bx = mfi.tilebox();
+
+            auto skip = burn_skip_count.const_array(mfi);
+            auto burn_stats = stats->array(mfi);
+
+            amrex::ParallelFor(bx,
+            [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+            {
+                if (skip(i,j,k) > 0) {
+                    burn_stats(i,j,k,2) = burn_status_skipped;
+                }
+            });
+        }
     }
 
-    ReduceTuple hv = reduce_data.value();
-    Real burn_failed = amrex::get<0>(hv);
+    if (react_stats == 1) {
+        write_burn_stats(*stats, thread_time, time, dt);
+    }
 
     if (burn_failed != 0.0) {
       burn_success = 0;
@@ -285,167 +1024,134 @@ Castro::react_state(Real time, Real dt)
 
     MultiFab& reactions = get_new_data(Reactions_Type);
 
-    reactions.setVal(0.0, reactions.nGrow());
-
-    // Start off assuming a successful burn.
-
-    int burn_success = 1;
+    // Optionally pack the zones that will burn.  This needs the burn
+    // weights of the last burn, so it comes before we reset the
+    // reaction data.
 
-    ReduceOps<ReduceOpSum> reduce_op;
-    ReduceData<Real> reduce_data(reduce_op);
+    const bool pack_zones = react_pack_zones == 1;
 
-    using ReduceTuple = typename decltype(reduce_data)::Type;
+    Vector<BurnZoneList> burn_lists;
 
-    for (MFIter mfi(S_new, TilingIfNotGPU()); mfi.isValid(); ++mfi)
-    {
+    if (pack_zones) {
+        build_burn_lists(S_old, S_new, reactions, ng, burn_lists);
+    }
 
-        const Box& bx = mfi.growntilebox(ng);
+    reactions.setVal(0.0, reactions.nGrow());
 
-        auto U_old = S_old.array(mfi);
-        auto U_new = S_new.array(mfi);
-        auto asrc = A_src.array(mfi);
-        auto react_src = reactions.array(mfi);
+    // Optionally record the statistics of the burn in each zone, and
+    // the time each thread spends burning.
 
-        int lsdc_iteration = sdc_iteration;
+    MultiFab stats_tmp;
+    MultiFab* stats = burn_stats_data(stats_tmp);
 
-        reduce_op.eval(bx, reduce_data,
-        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> ReduceTuple
-        {
+    Vector<Real> thread_time(OpenMP::get_max_threads(), 0.0);
 
-            burn_t burn_state;
+    // Start off assuming a successful burn.
 
-            // Initialize some data for later.
+    int burn_success = 1;
 
-            bool do_burn = true;
-            burn_state.success = true;
-            Real burn_failed = 0.0_rt;
+    Real burn_failed = 0.0;
 
-            // Don't burn on zones inside shock regions, if the
-            // relevant option is set.
+    const int lsdc_iteration = sdc_iteration;
 
-#ifdef SHOCK_VAR
-            if (U_new(i,j,k,USHK) > 0.0_rt && disable_shock_burning == 1) {
-                do_burn = false;
-            }
-#endif
+    if (react_dynamic_schedule == 1 && Gpu::notInLaunchRegion()) {
 
-            // Feed in the old-time state data.
+        Vector<Array4<Real const>> U_old_arr(S_new.local_size());
+        Vector<Array4<Real>> U_new_arr(S_new.local_size());
+        Vector<Array4<Real const>> asrc_arr(S_new.local_size());
+        Vector<Array4<Real>> react_src_arr(S_new.local_size());
+        Vector<Array4<Real>> stats_arr(S_new.local_size());
 
-            burn_state.y[SRHO] = U_old(i,j,k,URHO);
-            burn_state.y[SMX] = U_old(i,j,k,UMX);
-            burn_state.y[SMY] = U_old(i,j,k,UMY);
-            burn_state.y[SMZ] = U_old(i,j,k,UMZ);
-            burn_state.y[SEDEN] = U_old(i,j,k,UEDEN);
-            burn_state.y[SEINT] = U_old(i,j,k,UEINT);
-            for (int n = 0; n < NumSpec; n++) {
-                burn_state.y[SFS+n] = U_old(i,j,k,UFS+n);
-            }
-#if NAUX_NET > 0
-            for (int n = 0; n < NumAux; n++) {
-                burn_state.y[SFX+n] = U_old(i,j,k,UFX+n);
+        for (MFIter mfi(S_new); mfi.isValid(); ++mfi) {
+            const int li = mfi.LocalIndex();
+            U_old_arr[li] = S_old.const_array(mfi);
+            U_new_arr[li] = S_new.array(mfi);
+            asrc_arr[li] = A_src.const_array(mfi);
+            react_src_arr[li] = reactions.array(mfi);
+            if (stats != nullptr) {
+                stats_arr[li] = stats->array(mfi);
             }
-#endif
-            // we need an initial T guess for the EOS
-            burn_state.T = U_old(i,j,k,UTEMP);
-
-            burn_state.rho = burn_state.y[SRHO];
+        }
 
-            // Don't burn if we're outside of the relevant (rho, T) range.
+        burn_failed = burn_zones_dynamic(S_new, ng, burn_lists, stats != nullptr ? &thread_time : nullptr,
+        [&] (const int li, const int i, const int j, const int k) -> Real
+        {
+            return burn_zone_simplified_sdc(i, j, k, U_old_arr[li], U_new_arr[li],
+                                            asrc_arr[li], react_src_arr[li],
+                                            dt, lsdc_iteration, stats_arr[li]);
+        });
 
-            if (U_old(i,j,k,UTEMP) < castro::react_T_min || U_old(i,j,k,UTEMP) > castro::react_T_max ||
-                U_old(i,j,k,URHO) < castro::react_rho_min || U_old(i,j,k,URHO) > castro::react_rho_max) {
-                do_burn = false;
-            }
+    } else {
 
-             // Tell the integrator about the non-reacting source terms.
+        ReduceOps<ReduceOpSum> reduce_op;
+        ReduceData<Real> reduce_data(reduce_op);
 
-             burn_state.ydot_a[SRHO] = asrc(i,j,k,URHO);
-             burn_state.ydot_a[SMX] = asrc(i,j,k,UMX);
-             burn_state.ydot_a[SMY] = asrc(i,j,k,UMY);
-             burn_state.ydot_a[SMZ] = asrc(i,j,k,UMZ);
-             burn_state.ydot_a[SEDEN] = asrc(i,j,k,UEDEN);
-             burn_state.ydot_a[SEINT] = asrc(i,j,k,UEINT);
-             for (int n = 0; n < NumSpec; n++) {
-                 burn_state.ydot_a[SFS+n] = asrc(i,j,k,UFS+n);
-             }
-             for (int n = 0; n < NumAux; n++) {
-                 burn_state.ydot_a[SFX+n] = asrc(i,j,k,UFX+n);
-             }
+        using ReduceTuple = typename decltype(reduce_data)::Type;
 
-             // dual energy formalism: in doing EOS calls in the burn,
-             // switch between e and (E - K) depending on (E - K) / E.
+        // the burn lists are per box, so we do not tile then
 
-             burn_state.T_from_eden = false;
+        for (MFIter mfi(S_new, pack_zones ? MFItInfo() : get_react_tiling()); mfi.isValid(); ++mfi)
+        {
 
-             burn_state.i = i;
-             burn_state.j = j;
-             burn_state.k = k;
+            const Real box_start_time = box_timer_start();
 
-             burn_state.sdc_iter = lsdc_iteration;
-             burn_state.num_sdc_iters = sdc_iters;
+            auto U_old = S_old.const_array(mfi);
+            auto U_new = S_new.array(mfi);
+            auto asrc = A_src.const_array(mfi);
+            auto react_src = reactions.array(mfi);
+            auto burn_stats = stats != nullptr ? stats->array(mfi) : Array4<Real>{};
 
-             if (do_burn) {
-                 burner(burn_state, dt);
-             }
+            const Real thread_start_time = stats != nullptr ? ParallelDescriptor::second() : 0.0;
 
-             // If we were unsuccessful, update the failure count.
+            if (pack_zones) {
 
-             if (!burn_state.success) {
-                 burn_failed = 1.0_rt;
-             }
+                const BurnZoneList& list = burn_lists[mfi.LocalIndex()];
 
-             if (do_burn) {
+                const int* const zi = list.i.data();
+                const int* const zj = list.j.data();
+                const int* const zk = list.k.data();
 
-                 // update the state data.
+                reduce_op.eval(list.size(), reduce_data,
+                [=] AMREX_GPU_HOST_DEVICE (int n) -> ReduceTuple
+                {
+                    return {burn_zone_simplified_sdc(zi[n], zj[n], zk[n], U_old, U_new, asrc, react_src,
+                                                     dt, lsdc_iteration, burn_stats)};
+                });
 
-                 U_new(i,j,k,UEDEN) = burn_state.y[SEDEN];
-                 U_new(i,j,k,UEINT) = burn_state.y[SEINT];
-                 for (int n = 0; n < NumSpec; n++) {
-                     U_new(i,j,k,UFS+n) = burn_state.y[SFS+n];
-                 }
-#if NAUX_NET > 0
-                 for (int n = 0; n < NumAux; n++) {
-                     U_new(i,j,k,UFX+n) = burn_state.y[SFX+n];
-                 }
-#endif
+            } else {
 
-                 if (react_src.contains(i,j,k)) {
-                     // store the reaction data for the plotfile.
-                     // Note, we want to just capture the reaction
-                     // portion here, so we subtract off the advective
-                     // part.
+                const Box& bx = mfi.growntilebox(ng);
 
-                     // rho enuc
-                     react_src(i,j,k,0) = (U_new(i,j,k,UEINT) - U_old(i,j,k,UEINT)) / dt - asrc(i,j,k, UEINT);
+                reduce_op.eval(bx, reduce_data,
+                [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> ReduceTuple
+                {
+                    return {burn_zone_simplified_sdc(i, j, k, U_old, U_new, asrc, react_src,
+                                                     dt, lsdc_iteration, burn_stats)};
+                });
 
-                     // burn weights
-                     react_src(i,j,k,1) = amrex::max(1.0_rt, static_cast<Real>(burn_state.n_rhs + 2 * burn_state.n_jac));
+            }
 
-                     if (store_omegadot) {
-                         // rho omegadot_k
-                         for (int n = 0; n < NumSpec; ++n) {
-                             react_src(i,j,k,2+n) = (U_new(i,j,k,UFS+n) - U_old(i,j,k,UFS+n)) / dt - asrc(i,j,k,UFS+n);
-                         }
-#if NAUX_NET > 0
-                         // rho auxdot_k
-                         for (int n = 0; n < NumAux; ++n) {
-                             react_src(i,j,k,2+n+NumSpec) = (U_new(i,j,k,UFX+n) - U_old(i,j,k,UFX+n)) / dt - asrc(i,j,k,UFX+n);
-                         }
-#endif
-                     }
+            record_box_cost(mfi.index(), box_start_time);
 
-                 }
+            if (stats != nullptr) {
+                Gpu::streamSynchronize();
+                thread_time[OpenMP::get_thread_num()] += ParallelDescriptor::second() - thread_start_time;
+            }
 
-             }
+        }
 
+        ReduceTuple hv = reduce_data.value();
+        burn_failed = amrex::get<0>(hv);
 
-             return {burn_failed};
-        });
+        if (!pack_zones) {
+            record_tile_timing(react_tile_tuner[level], strt_time);
+        }
 
     }
 
-    ReduceTuple hv = reduce_data.value();
-    Real burn_failed = amrex::get<0>(hv);
+    if (react_stats == 1) {
+        write_burn_stats(*stats, thread_time, time, dt);
+    }
 
     if (burn_failed != 0.0) burn_success = 0;
 
@@ -49,7 +49,8 @@ Castro::source_flag(int src)
             return false;
 #ifndef MHD
     case thermo_src:
-        if (time_integration_method == SpectralDeferredCorrections)
+        if (time_integration_method == SpectralDeferredCorrections ||
+            time_integration_method == LowStorageRungeKutta)
           return true;
         else
           return false;
@@ -68,7 +69,8 @@ Castro::source_flag(int src)
 #ifdef DIFFUSION
     case diff_src:
         if (diffuse_temp &&
-            !(time_integration_method == SpectralDeferredCorrections)) {
+            !(time_integration_method == SpectralDeferredCorrections ||
+              time_integration_method == LowStorageRungeKutta)) {
           return true;
         }
         else {
@@ -256,7 +258,8 @@ Castro::construct_old_source(int src, MultiFab& source, MultiFab& state_in, Real
 
 #ifdef DIFFUSION
     case diff_src:
-        if (!(time_integration_method == SpectralDeferredCorrections)) {
+        if (!(time_integration_method == SpectralDeferredCorrections ||
+              time_integration_method == LowStorageRungeKutta)) {
           // for MOL or SDC, we'll compute a diffusive flux in the MOL routine
           construct_old_diff_source(source, state_in, time, dt);
         }
@@ -8,7 +8,8 @@ Castro::construct_old_thermo_source(MultiFab& source, MultiFab& state_in, Real t
 {
 
 #ifndef MHD
-  if (!(time_integration_method == SpectralDeferredCorrections)) return;
+  if (!(time_integration_method == SpectralDeferredCorrections ||
+        time_integration_method == LowStorageRungeKutta)) return;
 #endif
 
   const Real strt_time = ParallelDescriptor::second();
@@ -49,7 +50,8 @@ Castro::construct_new_thermo_source(MultiFab& source, MultiFab& state_old, Multi
 {
 
 #ifndef MHD
-  if (!(time_integration_method == SpectralDeferredCorrections)) return;
+  if (!(time_integration_method == SpectralDeferredCorrections ||
+        time_integration_method == LowStorageRungeKutta)) return;
 
   amrex::Abort("you should not get here!");
 #else
@@ -0,0 +1,72 @@
+#!/bin/bash
+
+# compare the results of Castro built with the interface states stored
+# in double precision (the default) and in single precision
+# (USE_FLOAT_EDGE_STATES=TRUE) on a few standard hydro problems.
+#
+# For each problem, we build both versions, run them to completion, and
+# then use the AMReX fcompare tool to report the absolute and relative
+# differences in each variable of the final plotfile.
+#
+# usage: ./compare_edge_precision.sh [CASTRO_HOME]
+#
+# the fcompare executable can be set with the FCOMPARE environment
+# variable, and extra make options (e.g. COMP=intel) with MAKE_OPTS.
+
+CASTRO_HOME=${1:-$(cd "$(dirname "$0")/../.." && pwd)}
+FCOMPARE=${FCOMPARE:-fcompare.gnu.ex}
+MAKE_OPTS=${MAKE_OPTS:-}
+NPROCS=${NPROCS:-8}
+
+# problem directory, dimensionality, and inputs file
+
+tests=(
+    "hydro_tests/Sod 3 inputs-sod-x"
+    "hydro_tests/Sedov 3 inputs.3d.sph.testsuite"
+    "hydro_tests/double_mach_reflection 2 inputs.2d.test"
+)
+
+for t in "${tests[@]}"; do
+
+    read -r dir dim inputs <<< "${t}"
+    name=$(basename "${dir}")
+
+    cd "${CASTRO_HOME}/Exec/${dir}" || exit 1
+
+    echo "========================================================="
+    echo " ${name} (${dim}-d, ${inputs})"
+    echo "========================================================="
+
+    for precision in double float; do
+
+        if [ ${precision} == "float" ]; then
+            edge_opt="USE_FLOAT_EDGE_STATES=TRUE"
+        else
+            edge_opt="USE_FLOAT_EDGE_STATES=FALSE"
+        fi
+
+        make realclean DIM=${dim} > /dev/null 2>&1
+        make -j ${NPROCS} DIM=${dim} USE_MPI=FALSE USE_OMP=FALSE ${edge_opt} ${MAKE_OPTS} > build.${precision}.out 2>&1 || {
+            echo "build failed, see ${dir}/build.${precision}.out"
+            exit 1
+        }
+
+        exe=$(ls -t Castro${dim}d*.ex | head -1)
+        mv "${exe}" "Castro.${precision}.ex"
+
+        ./Castro.${precision}.ex ${inputs} amr.plot_file=${name}_${precision}_plt \
+            amr.checkpoint_files_output=0 > run.${precision}.out 2>&1 || {
+            echo "run failed, see ${dir}/run.${precision}.out"
+            exit 1
+        }
+
+    done
+
+    pdouble=$(ls -d ${name}_double_plt* | grep -v old | sort | tail -1)
+    pfloat=$(ls -d ${name}_float_plt* | grep -v old | sort | tail -1)
+
+    ${FCOMPARE} --abort_if_not_all_found 0 "${pdouble}" "${pfloat}"
+
+    echo ""
+
+done